@@ -2,11 +2,408 @@
 #include "opaque_string_wrapper.h"
 #include "platform_activation.h"
 #include "pal_error.h"
+#include "string_convert.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <vector>
 
 namespace xlang::impl
 {
     template <typename char_type>
-    xlang_error_info* get_activation_factory(
+    filesystem_string to_filesystem_string(std::basic_string_view<char_type> value)
+    {
+        if constexpr (sizeof(char_type) == sizeof(filesystem_char_type))
+        {
+            return { value.begin(), value.end() };
+        }
+        else if constexpr (sizeof(char_type) == sizeof(xlang_char8))
+        {
+            std::basic_string_view<xlang_char8> const source{ reinterpret_cast<xlang_char8 const*>(value.data()), value.size() };
+            uint32_t const length = get_converted_length(source);
+            filesystem_string result(length, filesystem_char_type{});
+            convert_string(source, reinterpret_cast<char16_t*>(result.data()), length);
+            return result;
+        }
+        else
+        {
+            uint32_t const length = get_converted_length(value);
+            filesystem_string result(length, filesystem_char_type{});
+            convert_string(value, reinterpret_cast<xlang_char8*>(result.data()), length);
+            return result;
+        }
+    }
+
+    inline std::string_view trim(std::string_view value) noexcept
+    {
+        auto const first = value.find_first_not_of(" \t\r");
+        if (first == value.npos)
+        {
+            return {};
+        }
+        return value.substr(first, value.find_last_not_of(" \t\r") - first + 1);
+    }
+
+    // Modules registered for namespaces, directly or through a manifest, and additional directories to search
+    // for modules. A registered module also covers the namespaces nested in its namespace, so activating types
+    // from a registered namespace never probes the loader for modules that don't exist.
+    struct activation_modules
+    {
+        // Modules named by XLANG_ACTIVATION_PRELOAD are loaded here rather than while the instance is being
+        // constructed, since loading a module runs its initializers, which may activate types and so re-enter
+        // instance(). Only the first caller loads them, and a re-entrant call finds nothing left to load.
+        static activation_modules& instance()
+        {
+            static activation_modules modules;
+            if (modules.m_preload_pending.load(std::memory_order_acquire))
+            {
+                modules.preload_from_environment();
+            }
+            return modules;
+        }
+
+        bool configured() const noexcept
+        {
+            return m_configured.load(std::memory_order_acquire);
+        }
+
+        void add_search_paths(std::basic_string_view<filesystem_char_type> paths)
+        {
+            std::unique_lock const guard{ m_lock };
+            while (!paths.empty())
+            {
+                auto const end = std::min(paths.find(path_list_separator), paths.size());
+                if (end != 0)
+                {
+                    m_search_paths.emplace_back(paths.substr(0, end));
+                }
+                paths.remove_prefix(std::min(end + 1, paths.size()));
+            }
+            m_configured.store(true, std::memory_order_release);
+        }
+
+        void register_module(filesystem_string module_namespace, filesystem_string module_path)
+        {
+            std::unique_lock const guard{ m_lock };
+            m_modules.insert_or_assign(std::move(module_namespace), module_entry{ std::move(module_path) });
+            m_configured.store(true, std::memory_order_release);
+        }
+
+        void remove_search_paths(std::basic_string_view<filesystem_char_type> paths)
+        {
+            std::unique_lock const guard{ m_lock };
+            while (!paths.empty())
+            {
+                auto const end = std::min(paths.find(path_list_separator), paths.size());
+                auto const found = std::find(m_search_paths.begin(), m_search_paths.end(), paths.substr(0, end));
+                if (found != m_search_paths.end())
+                {
+                    m_search_paths.erase(found);
+                }
+                paths.remove_prefix(std::min(end + 1, paths.size()));
+            }
+        }
+
+        void unregister_module(filesystem_string const& module_namespace)
+        {
+            std::unique_lock const guard{ m_lock };
+            auto const found = m_modules.find(module_namespace);
+            if (found != m_modules.end())
+            {
+                m_modules.erase(found);
+            }
+        }
+
+        // Registers every entry of a manifest and returns the registered namespaces. Each line of a manifest
+        // has the form "namespace = path", and lines starting with '#' are comments. Relative paths are
+        // relative to the directory containing the manifest, which is resolved against the current directory
+        // now, so that later changes of the current directory or the loader's search path don't affect them.
+        std::vector<filesystem_string> load_manifest(filesystem_string const& relative_manifest_path)
+        {
+            filesystem_string const manifest_path = get_absolute_path(relative_manifest_path);
+            std::string contents;
+            if (!try_read_file(manifest_path, contents))
+            {
+                throw_result(xlang_result::invalid_arg, "Unable to read activation manifest");
+            }
+
+            filesystem_string directory;
+            auto const directory_end = manifest_path.find_last_of(filesystem_string{ path_separator, filesystem_char_type{ '/' } });
+            if (directory_end != manifest_path.npos)
+            {
+                directory = manifest_path.substr(0, directory_end + 1);
+            }
+
+            std::vector<std::pair<filesystem_string, filesystem_string>> entries;
+            std::string_view remaining{ contents };
+            while (!remaining.empty())
+            {
+                auto const end = std::min(remaining.find('\n'), remaining.size());
+                auto const line = trim(remaining.substr(0, end));
+                remaining.remove_prefix(std::min(end + 1, remaining.size()));
+
+                if (line.empty() || line[0] == '#')
+                {
+                    continue;
+                }
+
+                auto const separator = line.find('=');
+                auto const module_namespace = trim(line.substr(0, std::min(separator, line.size())));
+                auto const module_path = separator == line.npos ? std::string_view{} : trim(line.substr(separator + 1));
+                if (module_namespace.empty() || module_path.empty())
+                {
+                    throw_result(xlang_result::invalid_arg, "Malformed activation manifest entry");
+                }
+
+                filesystem_string path = to_filesystem_string(module_path);
+                if (is_relative_path(path))
+                {
+                    path.insert(0, directory);
+                }
+                entries.emplace_back(to_filesystem_string(module_namespace), std::move(path));
+            }
+
+            // Nothing is registered unless the whole manifest is valid.
+            std::vector<filesystem_string> namespaces;
+            namespaces.reserve(entries.size());
+            for (auto& [module_namespace, module_path] : entries)
+            {
+                namespaces.push_back(module_namespace);
+                register_module(std::move(module_namespace), std::move(module_path));
+            }
+            return namespaces;
+        }
+
+        // Loads the module registered for a namespace ahead of its first activation.
+        bool preload(filesystem_string const& module_namespace)
+        {
+            filesystem_string module_path;
+            {
+                std::shared_lock const guard{ m_lock };
+                auto const found = m_modules.find(module_namespace);
+                if (found == m_modules.end())
+                {
+                    return false;
+                }
+                if (found->second.loaded)
+                {
+                    return found->second.pfn != nullptr;
+                }
+                module_path = found->second.path;
+            }
+            return load(module_namespace, module_path) != nullptr;
+        }
+
+        // Returns no value if nothing is known about the namespace, in which case the platform loader's own
+        // search is used.
+        std::optional<xlang_pfn_lib_get_activation_factory> resolve(filesystem_string const& module_namespace)
+        {
+            filesystem_string module_path;
+            std::vector<filesystem_string> search_paths;
+            {
+                std::shared_lock const guard{ m_lock };
+                auto const found = m_modules.find(module_namespace);
+                if (found != m_modules.end())
+                {
+                    if (found->second.loaded)
+                    {
+                        return found->second.pfn;
+                    }
+                    module_path = found->second.path;
+                }
+                else
+                {
+                    for (auto outer = enclosing_namespace(std::basic_string_view<filesystem_char_type>{ module_namespace });
+                        !outer.empty();
+                        outer = enclosing_namespace(outer))
+                    {
+                        if (m_modules.find(outer) != m_modules.end())
+                        {
+                            return xlang_pfn_lib_get_activation_factory{};
+                        }
+                    }
+                    search_paths = m_search_paths;
+                }
+            }
+
+            if (!module_path.empty())
+            {
+                return load(module_namespace, module_path);
+            }
+
+            for (auto const& directory : search_paths)
+            {
+                filesystem_string path{ directory };
+                if (path.back() != path_separator)
+                {
+                    path += path_separator;
+                }
+                append_module_file_name(path, module_namespace);
+                if (auto const pfn = try_get_activation_func_from_path(path))
+                {
+                    return pfn;
+                }
+            }
+            return std::nullopt;
+        }
+
+    private:
+        struct module_entry
+        {
+            filesystem_string path;
+            xlang_pfn_lib_get_activation_factory pfn{};
+            bool loaded{};
+        };
+
+        activation_modules() noexcept
+        {
+            // Configuration from the environment is best effort, since there is no caller to report errors to.
+            try
+            {
+                filesystem_string value;
+                if (try_get_environment_variable("XLANG_MODULE_PATH", value))
+                {
+                    add_search_paths(value);
+                }
+                if (try_get_environment_variable("XLANG_ACTIVATION_MANIFEST", value) && !value.empty())
+                {
+                    auto namespaces = load_manifest(value);
+                    filesystem_string preload_value;
+                    if (try_get_environment_variable("XLANG_ACTIVATION_PRELOAD", preload_value) &&
+                        !preload_value.empty() && preload_value != filesystem_string(1, filesystem_char_type{ '0' }))
+                    {
+                        m_pending_preloads = std::move(namespaces);
+                        m_preload_pending.store(!m_pending_preloads.empty(), std::memory_order_release);
+                    }
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+
+        void preload_from_environment() noexcept
+        {
+            if (!m_preload_pending.exchange(false, std::memory_order_acq_rel))
+            {
+                return;
+            }
+
+            // Preloading is best effort, as with the rest of the configuration from the environment.
+            for (auto const& module_namespace : m_pending_preloads)
+            {
+                try
+                {
+                    preload(module_namespace);
+                }
+                catch (...)
+                {
+                }
+            }
+        }
+
+        // Modules are loaded outside of the lock, since loading a module runs its initializers, which may
+        // activate other types.
+        xlang_pfn_lib_get_activation_factory load(filesystem_string const& module_namespace, filesystem_string const& module_path)
+        {
+            xlang_pfn_lib_get_activation_factory const pfn = try_get_activation_func_from_path(module_path);
+
+            std::unique_lock const guard{ m_lock };
+            auto const found = m_modules.find(module_namespace);
+            if (found != m_modules.end() && found->second.path == module_path)
+            {
+                found->second.pfn = pfn;
+                found->second.loaded = true;
+            }
+            return pfn;
+        }
+
+        std::shared_mutex m_lock;
+        std::map<filesystem_string, module_entry, std::less<>> m_modules;
+        std::vector<filesystem_string> m_search_paths;
+        std::atomic<bool> m_configured{ false };
+        std::vector<filesystem_string> m_pending_preloads;
+        std::atomic<bool> m_preload_pending{ false };
+    };
+
+    template <typename char_type>
+    xlang_pfn_lib_get_activation_factory resolve_activation_func(std::basic_string_view<char_type> module_namespace)
+    {
+        auto& modules = activation_modules::instance();
+        if (modules.configured())
+        {
+            if (auto const pfn = modules.resolve(to_filesystem_string(module_namespace)))
+            {
+                return *pfn;
+            }
+        }
+        return try_get_activation_func(module_namespace);
+    }
+
+    // Remembers the activation function exported by the module for each namespace, including namespaces that have
+    // no module, so that repeated activations do not probe the loader again. Lookups only take a shared lock.
+    template <typename char_type>
+    struct activation_func_cache
+    {
+        static xlang_pfn_lib_get_activation_factory get(std::basic_string_view<char_type> module_namespace)
+        {
+            {
+                std::shared_lock const guard{ m_lock };
+                auto const found = m_entries.find(module_namespace);
+                if (found != m_entries.end())
+                {
+                    return found->second;
+                }
+            }
+
+            // Resolve outside of the lock, since loading a module may be slow or may itself activate types. The
+            // result is dropped if the cache was invalidated in the meantime, as it may already be out of date.
+            auto const generation = m_generation.load(std::memory_order_acquire);
+            xlang_pfn_lib_get_activation_factory const pfn = resolve_activation_func(module_namespace);
+
+            std::unique_lock const guard{ m_lock };
+            if (generation == m_generation.load(std::memory_order_relaxed))
+            {
+                m_entries.emplace(module_namespace, pfn);
+            }
+            return pfn;
+        }
+
+        static void invalidate(std::basic_string_view<char_type> module_namespace)
+        {
+            std::unique_lock const guard{ m_lock };
+            m_generation.fetch_add(1, std::memory_order_release);
+            if (module_namespace.empty())
+            {
+                m_entries.clear();
+            }
+            else
+            {
+                auto const found = m_entries.find(module_namespace);
+                if (found != m_entries.end())
+                {
+                    m_entries.erase(found);
+                }
+            }
+        }
+
+    private:
+        inline static std::shared_mutex m_lock;
+        inline static std::map<std::basic_string<char_type>, xlang_pfn_lib_get_activation_factory, std::less<>> m_entries;
+        inline static std::atomic<uint32_t> m_generation{ 0 };
+    };
+
+    inline void invalidate_activation_func_caches()
+    {
+        activation_func_cache<xlang_char8>::invalidate({});
+        activation_func_cache<char16_t>::invalidate({});
+    }
+
+    template <typename char_type>
+    xlang_result get_activation_factory(
         xlang_string class_name,
         xlang_guid const& iid,
         void** factory)
@@ -15,21 +412,43 @@ namespace xlang::impl
             !current_namespace.empty();
             current_namespace = enclosing_namespace(current_namespace))
         {
-            xlang_pfn_lib_get_activation_factory pfn = try_get_activation_func(current_namespace);
+            xlang_pfn_lib_get_activation_factory pfn = activation_func_cache<char_type>::get(current_namespace);
             if (pfn)
             {
                 xlang_result result = (*pfn)(class_name, iid, factory);
-                if (result == xlang_result::success)
-                {
-                    return nullptr;
-                }
-                else if (result != xlang_result::type_load)
+                if (result != xlang_result::type_load)
                 {
-                    throw_result(result);
+                    return result;
                 }
             }
         }
-        return xlang_originate_error(xlang_result::type_load);
+        return xlang_result::type_load;
+    }
+
+    // Failures are reported as result codes, so that callers probing for optional classes don't pay for
+    // originating an error.
+    xlang_result get_activation_factory(
+        xlang_string class_name,
+        xlang_guid const& iid,
+        void** factory)
+    {
+        if (!class_name)
+        {
+            return xlang_result::invalid_arg;
+        }
+
+        auto const encoding = xlang_get_string_encoding(class_name);
+        if (encoding == (xlang_string_encoding::utf8 | xlang_string_encoding::utf16))
+        {
+            return get_activation_factory<filesystem_char_type>(class_name, iid, factory);
+        }
+
+        if (encoding == xlang_string_encoding::utf8)
+        {
+            return get_activation_factory<xlang_char8>(class_name, iid, factory);
+        }
+
+        return get_activation_factory<char16_t>(class_name, iid, factory);
     }
 }
 
@@ -42,27 +461,184 @@ XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_activation_factory(
 ) noexcept
 try
 {
-    if (!class_name)
+    xlang_result const result = get_activation_factory(class_name, iid, factory);
+    if (result != xlang_result::success)
+    {
+        *factory = nullptr;
+        return xlang_originate_error(result);
+    }
+    return nullptr;
+}
+catch (...)
+{
+    *factory = nullptr;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_try_get_activation_factory(
+    xlang_string class_name,
+    xlang_guid const& iid,
+    void** factory
+) noexcept
+try
+{
+    xlang_result const result = get_activation_factory(class_name, iid, factory);
+    if (result != xlang_result::success)
+    {
+        *factory = nullptr;
+    }
+    return result;
+}
+catch (...)
+{
+    *factory = nullptr;
+
+    // Only unexpected failures, such as running out of memory, originate an error here.
+    xlang_result result{ xlang_result::fail };
+    if (xlang_error_info* const error_info = xlang::to_result())
+    {
+        error_info->GetError(&result);
+        error_info->Release();
+    }
+    return result;
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_invalidate_activation_cache(
+    xlang_string namespace_name
+) noexcept
+try
+{
+    if (namespace_name)
+    {
+        activation_func_cache<xlang_char8>::invalidate(to_string_view<xlang_char8>(namespace_name));
+        activation_func_cache<char16_t>::invalidate(to_string_view<char16_t>(namespace_name));
+    }
+    else
+    {
+        invalidate_activation_func_caches();
+    }
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_add_module_search_path(
+    xlang_string directory
+) noexcept
+try
+{
+    if (!directory)
     {
         xlang::throw_result(xlang_result::invalid_arg);
     }
 
-    auto const encoding = xlang_get_string_encoding(class_name);
-    if (encoding == (xlang_string_encoding::utf8 | xlang_string_encoding::utf16))
+    activation_modules::instance().add_search_paths(to_string_view<filesystem_char_type>(directory));
+    invalidate_activation_func_caches();
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_register_activation_module(
+    xlang_string namespace_name,
+    xlang_string module_path,
+    bool preload
+) noexcept
+try
+{
+    if (!namespace_name || !module_path)
     {
-        return get_activation_factory<filesystem_char_type>(class_name, iid, factory);
+        xlang::throw_result(xlang_result::invalid_arg);
     }
 
-    if (encoding == xlang_string_encoding::utf8)
+    filesystem_string module_namespace{ to_string_view<filesystem_char_type>(namespace_name) };
+    auto& modules = activation_modules::instance();
+    modules.register_module(module_namespace, filesystem_string{ to_string_view<filesystem_char_type>(module_path) });
+    invalidate_activation_func_caches();
+
+    if (preload && !modules.preload(module_namespace))
     {
-        return get_activation_factory<xlang_char8>(class_name, iid, factory);
+        xlang::throw_result(xlang_result::type_load, "Unable to load activation module");
     }
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
 
-    return get_activation_factory<char16_t>(class_name, iid, factory);
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_load_activation_manifest(
+    xlang_string manifest_path,
+    bool preload
+) noexcept
+try
+{
+    if (!manifest_path)
+    {
+        xlang::throw_result(xlang_result::invalid_arg);
+    }
 
+    auto& modules = activation_modules::instance();
+    auto const namespaces = modules.load_manifest(filesystem_string{ to_string_view<filesystem_char_type>(manifest_path) });
+    invalidate_activation_func_caches();
+
+    if (preload)
+    {
+        bool loaded_all{ true };
+        for (auto const& module_namespace : namespaces)
+        {
+            loaded_all = modules.preload(module_namespace) && loaded_all;
+        }
+        if (!loaded_all)
+        {
+            xlang::throw_result(xlang_result::type_load, "Unable to load activation module");
+        }
+    }
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_remove_module_search_path(
+    xlang_string directory
+) noexcept
+try
+{
+    if (!directory)
+    {
+        xlang::throw_result(xlang_result::invalid_arg);
+    }
+
+    activation_modules::instance().remove_search_paths(to_string_view<filesystem_char_type>(directory));
+    invalidate_activation_func_caches();
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_unregister_activation_module(
+    xlang_string namespace_name
+) noexcept
+try
+{
+    if (!namespace_name)
+    {
+        xlang::throw_result(xlang_result::invalid_arg);
+    }
+
+    activation_modules::instance().unregister_module(filesystem_string{ to_string_view<filesystem_char_type>(namespace_name) });
+    invalidate_activation_func_caches();
+    return nullptr;
 }
 catch (...)
 {
-    *factory = nullptr;
     return xlang::to_result();
 }
\ No newline at end of file
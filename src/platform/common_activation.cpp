@@ -2,8 +2,13 @@
 #include "platform_activation.h"
 #include "string_convert.h"
 #include "pal_error.h"
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <dlfcn.h>
+#include <unistd.h>
 
 namespace xlang::impl
 {
@@ -22,15 +27,15 @@ namespace xlang::impl
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
         std::basic_string_view<xlang_char8> module_namespace)
     {
-        void* module{};
-
         std::string module_name{};
-        module_name.reserve(module_namespace.size() + 6); // 6 == len("lib") + len(".so")
-        module_name += "lib";
-        module_name += module_namespace;
-        module_name += ".so";
+        append_module_file_name(module_name, { reinterpret_cast<char const*>(module_namespace.data()), module_namespace.size() });
+        return try_get_activation_func_from_path(module_name);
+    }
 
-        module = dlopen(module_name.c_str(), RTLD_LAZY);
+    xlang_pfn_lib_get_activation_factory try_get_activation_func_from_path(
+        std::string const& module_path)
+    {
+        void* module = dlopen(module_path.c_str(), RTLD_LAZY);
 
         if (module)
         {
@@ -39,4 +44,61 @@ namespace xlang::impl
 
         return nullptr;
     }
+
+    void append_module_file_name(
+        std::string& path,
+        std::string_view module_namespace)
+    {
+        path.reserve(path.size() + module_namespace.size() + 6); // 6 == len("lib") + len(".so")
+        path += "lib";
+        path += module_namespace;
+        path += ".so";
+    }
+
+    bool try_get_environment_variable(std::string_view name, std::string& value)
+    {
+        char const* const result = std::getenv(std::string{ name }.c_str());
+        if (!result)
+        {
+            return false;
+        }
+        value = result;
+        return true;
+    }
+
+    bool try_read_file(std::string const& path, std::string& contents)
+    {
+        std::ifstream file{ path, std::ios::in | std::ios::binary };
+        if (!file)
+        {
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+        return !file.bad();
+    }
+
+    filesystem_string get_absolute_path(filesystem_string const& path)
+    {
+        if (!is_relative_path(path))
+        {
+            return path;
+        }
+
+        std::string directory(256, '\0');
+        while (!::getcwd(directory.data(), directory.size()))
+        {
+            if (errno != ERANGE)
+            {
+                throw_result(xlang_result::fail, "Unable to get the current directory");
+            }
+            directory.resize(directory.size() * 2);
+        }
+        directory.resize(directory.find('\0'));
+
+        if (directory.back() != path_separator)
+        {
+            directory += path_separator;
+        }
+        return directory + path;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include <unwind.h>
+#include "pal.h"
+#include "platform_error.h"
+
+#ifdef _WIN32
+#error "This file is for targeting platforms other than Windows"
+#endif
+
+namespace xlang::impl
+{
+    namespace
+    {
+        struct unwind_state
+        {
+            void** frames;
+            uint32_t max_frame_count;
+            uint32_t frame_count;
+            uint32_t skip_count;
+        };
+
+        _Unwind_Reason_Code capture_frame(_Unwind_Context* context, void* arg) noexcept
+        {
+            auto& state = *static_cast<unwind_state*>(arg);
+            auto const ip = _Unwind_GetIP(context);
+            if (ip == 0)
+            {
+                return _URC_END_OF_STACK;
+            }
+
+            if (state.skip_count != 0)
+            {
+                --state.skip_count;
+                return _URC_NO_REASON;
+            }
+
+            state.frames[state.frame_count++] = reinterpret_cast<void*>(ip);
+            return state.frame_count == state.max_frame_count ? _URC_END_OF_STACK : _URC_NO_REASON;
+        }
+    }
+
+    uint32_t XLANG_CALL platform_capture_stack(void*, void** frames, uint32_t max_frame_count) noexcept
+    {
+        if (max_frame_count == 0)
+        {
+            return 0;
+        }
+
+        unwind_state state{ frames, max_frame_count, 0, 1 };
+        _Unwind_Backtrace(capture_frame, &state);
+        return state.frame_count;
+    }
+}
\ No newline at end of file
@@ -1,10 +1,185 @@
 #include "pal_internal.h"
 #include "pal_error.h"
 #include "atomic_ref_count.h"
+#include "platform_error.h"
 #include <xlang/base.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iterator>
+#include <memory>
 
 namespace xlang::impl
 {
+    inline constexpr uint32_t max_execution_trace_frames{ 64 };
+
+    struct execution_trace : xlang_execution_trace
+    {
+        static void* operator new(size_t count, std::nothrow_t const&) noexcept
+        {
+            return xlang_mem_alloc(count);
+        }
+
+        static void operator delete(void* ptr, std::nothrow_t const&) noexcept
+        {
+            xlang_mem_free_sized(ptr, sizeof(execution_trace));
+        }
+
+        static void operator delete(void* ptr) noexcept
+        {
+            xlang_mem_free_sized(ptr, sizeof(execution_trace));
+        }
+
+        int32_t XLANG_CALL QueryInterface(xlang_guid const& id, void** object) noexcept final
+        {
+            if (id == xlang_unknown_guid)
+            {
+                *object = static_cast<xlang_unknown*>(this);
+            }
+            else if (id == xlang_execution_trace_guid)
+            {
+                *object = static_cast<xlang_execution_trace*>(this);
+            }
+            else
+            {
+                *object = nullptr;
+                return xlang_hresult_no_interface;
+            }
+            AddRef();
+            return 0;
+        }
+
+        uint32_t XLANG_CALL AddRef() noexcept final
+        {
+            return ++m_count;
+        }
+
+        uint32_t XLANG_CALL Release() noexcept final
+        {
+            auto result = --m_count;
+            if (result == 0)
+            {
+                delete this;
+            }
+            return result;
+        }
+
+        void GetFrames(void* const** frames, uint32_t* frame_count) noexcept override
+        {
+            *frames = m_frames;
+            *frame_count = m_frame_count;
+        }
+
+        void* m_frames[max_execution_trace_frames]{};
+        uint32_t m_frame_count{};
+
+    private:
+        atomic_ref_count m_count;
+    };
+
+    // Trace options are replaced as a whole, so readers always see a consistent set. Checking the flag first
+    // keeps the cost of originating errors unchanged while tracing is disabled.
+    std::atomic<bool> tracing_enabled{ false };
+    std::shared_ptr<xlang_error_trace_options const> trace_options;
+
+    struct result_statistics
+    {
+        std::atomic<uint64_t> originated_count{};
+        std::atomic<uint64_t> traced_count{};
+    };
+
+    // Indexed by result code.
+    result_statistics error_statistics[static_cast<uint32_t>(xlang_result::type_load) + 1];
+
+    std::atomic<uint64_t> trace_sequence{};
+    std::atomic<int64_t> trace_window{};
+    std::atomic<uint32_t> trace_window_count{};
+
+    inline result_statistics& get_statistics(xlang_result error) noexcept
+    {
+        auto index = static_cast<uint32_t>(error);
+        if (index >= std::size(error_statistics))
+        {
+            index = static_cast<uint32_t>(xlang_result::fail);
+        }
+        return error_statistics[index];
+    }
+
+    // Decides whether this error is traced, allowing one error in every sample_interval, and no more than
+    // roughly max_traces_per_second per second across all threads.
+    inline bool should_trace(xlang_error_trace_options const& options) noexcept
+    {
+        if (options.sample_interval > 1 &&
+            trace_sequence.fetch_add(1, std::memory_order_relaxed) % options.sample_interval != 0)
+        {
+            return false;
+        }
+
+        if (options.max_traces_per_second == 0)
+        {
+            return true;
+        }
+
+        int64_t const now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        int64_t window = trace_window.load(std::memory_order_relaxed);
+        if (window != now && trace_window.compare_exchange_strong(window, now, std::memory_order_relaxed))
+        {
+            trace_window_count.store(0, std::memory_order_relaxed);
+        }
+        return trace_window_count.fetch_add(1, std::memory_order_relaxed) < options.max_traces_per_second;
+    }
+
+    inline com_ptr<xlang_unknown> try_capture_trace(xlang_result error) noexcept
+    {
+        com_ptr<xlang_unknown> result;
+        if (!tracing_enabled.load(std::memory_order_relaxed))
+        {
+            return result;
+        }
+
+        auto const options = std::atomic_load_explicit(&trace_options, std::memory_order_acquire);
+        if (!options || !should_trace(*options))
+        {
+            return result;
+        }
+
+        auto trace = new (std::nothrow) execution_trace{};
+        if (!trace)
+        {
+            return result;
+        }
+
+        uint32_t const max_frame_count = std::min(options->max_frame_count, max_execution_trace_frames);
+        if (options->capture_stack)
+        {
+            trace->m_frame_count = options->capture_stack(options->context, trace->m_frames, max_frame_count);
+        }
+        else
+        {
+            trace->m_frame_count = platform_capture_stack(nullptr, trace->m_frames, max_frame_count);
+        }
+        trace->m_frame_count = std::min(trace->m_frame_count, max_frame_count);
+        result.attach(static_cast<xlang_unknown*>(trace));
+
+        // An empty trace tells the caller nothing, so it is neither attached nor counted.
+        if (trace->m_frame_count == 0)
+        {
+            return {};
+        }
+
+        get_statistics(error).traced_count.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+
+    xlang_error_info* create_error_info(
+        xlang_result error,
+        xlang_string message,
+        xlang_string projection_identifier,
+        xlang_string language_error,
+        xlang_unknown* execution_trace,
+        xlang_unknown* language_information) noexcept;
+
     struct error_info : xlang_error_info
     {
         // Used to construct constant errors used in out of memory scenarios.
@@ -31,6 +206,22 @@ namespace xlang::impl
             m_language_information.copy_from(language_information);
         }
 
+        // Error infos cross the ABI, so they are allocated from the PAL allocator like other shared memory.
+        static void* operator new(size_t count, std::nothrow_t const&) noexcept
+        {
+            return xlang_mem_alloc(count);
+        }
+
+        static void operator delete(void* ptr, std::nothrow_t const&) noexcept
+        {
+            xlang_mem_free_sized(ptr, sizeof(error_info));
+        }
+
+        static void operator delete(void* ptr) noexcept
+        {
+            xlang_mem_free_sized(ptr, sizeof(error_info));
+        }
+
         int32_t XLANG_CALL QueryInterface(xlang_guid const& id, void** object) noexcept final
         {
             if (id == xlang_unknown_guid)
@@ -117,7 +308,7 @@ namespace xlang::impl
 
             com_ptr<xlang_error_info> propagated_error;
             propagated_error.attach(
-                xlang_originate_error(
+                create_error_info(
                     m_result,
                     m_message,
                     projection_identifier,
@@ -145,6 +336,8 @@ namespace xlang::impl
         atomic_ref_count m_count;
     };
 
+    // Shared, immutable errors for each result code. These are handed out when an error info can't be allocated,
+    // and in place of errors without details when lightweight origination is enabled.
     error_info error_code_errors [] = {
         error_info {xlang_result::access_denied},
         error_info {xlang_result::bounds},
@@ -158,6 +351,60 @@ namespace xlang::impl
         error_info {xlang_result::pointer},
         error_info {xlang_result::type_load}
     };
+
+    inline xlang_error_info* get_shared_error(xlang_result error) noexcept
+    {
+        // The table starts at the first failure code.
+        auto index = static_cast<uint32_t>(error);
+        if (index == 0 || index > std::size(error_code_errors))
+        {
+            index = static_cast<uint32_t>(xlang_result::fail);
+        }
+
+        error_info* result = &error_code_errors[index - 1];
+        result->AddRef();
+        return result;
+    }
+
+    std::atomic<xlang_error_origination> error_origination{ xlang_error_origination::rich };
+}
+
+namespace xlang::impl
+{
+    xlang_error_info* create_error_info(
+        xlang_result error,
+        xlang_string message,
+        xlang_string projection_identifier,
+        xlang_string language_error,
+        xlang_unknown* execution_trace,
+        xlang_unknown* language_information) noexcept
+    {
+        com_ptr<xlang_unknown> captured_trace;
+        if (!execution_trace)
+        {
+            captured_trace = try_capture_trace(error);
+            execution_trace = captured_trace.get();
+        }
+
+        xlang_error_info* result =
+            new (std::nothrow) error_info
+        {
+            error,
+            message,
+            projection_identifier,
+            language_error,
+            execution_trace,
+            language_information
+        };
+
+        // If failed to construct, use the statically allocated ones.
+        if (result == nullptr)
+        {
+            result = get_shared_error(error);
+        }
+
+        return result;
+    }
 }
 
 [[nodiscard]] XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_originate_error(
@@ -169,23 +416,88 @@ namespace xlang::impl
     xlang_unknown* language_information
 ) XLANG_NOEXCEPT
 {
-    xlang_error_info* error_info =
-        new (std::nothrow) xlang::impl::error_info
+    xlang::impl::get_statistics(error).originated_count.fetch_add(1, std::memory_order_relaxed);
+
+    // Errors without any details don't need their own error info, unless propagation must be recorded.
+    if (!message && !projection_identifier && !language_error && !execution_trace && !language_information &&
+        xlang::impl::error_origination.load(std::memory_order_relaxed) == xlang_error_origination::lightweight)
     {
+        return xlang::impl::get_shared_error(error);
+    }
+
+    return xlang::impl::create_error_info(
         error,
         message,
         projection_identifier,
         language_error,
         execution_trace,
-        language_information
-    };
+        language_information);
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_set_error_origination(xlang_error_origination origination) XLANG_NOEXCEPT
+{
+    xlang::impl::error_origination.store(origination, std::memory_order_relaxed);
+}
 
-    // If failed to construct, use the statically allocated ones.
-    if (error_info == nullptr)
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_set_error_trace_options(
+    xlang_error_trace_options const* options
+) XLANG_NOEXCEPT
+try
+{
+    using namespace xlang::impl;
+
+    if (!options)
     {
-        error_info = &xlang::impl::error_code_errors[static_cast<int>(error)];
-        error_info->AddRef();
+        tracing_enabled.store(false, std::memory_order_relaxed);
+        std::atomic_store_explicit(&trace_options, {}, std::memory_order_release);
+        return nullptr;
     }
 
-    return error_info;
+    if (options->max_frame_count == 0 || options->max_frame_count > max_execution_trace_frames)
+    {
+        xlang::throw_result(xlang_result::invalid_arg, "Unsupported execution trace frame count");
+    }
+
+    std::atomic_store_explicit(
+        &trace_options,
+        std::make_shared<xlang_error_trace_options const>(*options),
+        std::memory_order_release);
+    tracing_enabled.store(true, std::memory_order_relaxed);
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_error_statistics(
+    xlang_result error,
+    xlang_error_statistics* statistics
+) XLANG_NOEXCEPT
+try
+{
+    using namespace xlang::impl;
+
+    if (!statistics || static_cast<uint32_t>(error) >= std::size(error_statistics))
+    {
+        xlang::throw_result(xlang_result::invalid_arg);
+    }
+
+    auto const& counters = error_statistics[static_cast<uint32_t>(error)];
+    statistics->originated_count = counters.originated_count.load(std::memory_order_relaxed);
+    statistics->traced_count = counters.traced_count.load(std::memory_order_relaxed);
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_reset_error_statistics() XLANG_NOEXCEPT
+{
+    for (auto& counters : xlang::impl::error_statistics)
+    {
+        counters.originated_count.store(0, std::memory_order_relaxed);
+        counters.traced_count.store(0, std::memory_order_relaxed);
+    }
 }
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "atomic_ref_count.h"
 #include "heap_string.h"
 #include "cache_string.h"
+#include "string_allocate.h"
+#include "string_block_cache.h"
 
 namespace xlang::impl
 {
@@ -222,7 +224,11 @@ namespace xlang::impl
                 alternate->release();
             }
 
-            xlang_mem_free(this);
+            uint32_t const size = is_utf8() ?
+                packed_buffer_size<heap_string, xlang_char8>(get_length()) :
+                packed_buffer_size<heap_string, char16_t>(get_length());
+
+            string_block_cache::deallocate(this, size);
         }
         return result;
     }
@@ -233,7 +239,7 @@ namespace xlang::impl
         uint32_t length,
         cache_string* alternate)
     {
-        heap_string* new_string = reinterpret_cast<heap_string*>(xlang_mem_alloc(packed_buffer_size<heap_string, char_type>(length)));
+        heap_string* new_string = reinterpret_cast<heap_string*>(string_block_cache::allocate(packed_buffer_size<heap_string, char_type>(length)));
         if (!new_string)
         {
             throw std::bad_alloc{};
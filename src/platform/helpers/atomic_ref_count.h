@@ -28,6 +28,15 @@ namespace xlang::impl
 
     inline int32_t atomic_ref_count::operator--() noexcept
     {
+        // The sole owner can't race with anyone else, as new references can only be formed from an existing one,
+        // so releasing the last reference needn't be an atomic read-modify-write. The acquire load pairs with the
+        // release decrements that brought the count down to one.
+        if (count.load(std::memory_order_acquire) == 1)
+        {
+            count.store(0, std::memory_order_relaxed);
+            return 0;
+        }
+
         // This could be std::memory_order_acq_rel, but would result in an unneeded "aquire"
         // operations when the counter has not yet reached zero. This case is protected via the
         // fence later.
@@ -0,0 +1,165 @@
+#include "pal_internal.h"
+#include "pal_error.h"
+#include "platform_memory.h"
+#include <atomic>
+
+namespace xlang::impl
+{
+    // The installed allocator is copied into static storage and published through an atomic pointer.
+    // A null pointer means the platform default allocator is used.
+    xlang_mem_allocator installed_allocator{};
+    std::atomic<xlang_mem_allocator const*> current_allocator{ nullptr };
+
+    struct memory_statistics
+    {
+        std::atomic<bool> enabled{ false };
+        std::atomic<uint64_t> allocation_count{};
+        std::atomic<uint64_t> failed_allocation_count{};
+        std::atomic<uint64_t> free_count{};
+        std::atomic<uint64_t> bytes_allocated{};
+    };
+
+    memory_statistics statistics;
+
+    inline void record_alloc(void* ptr, size_t count) noexcept
+    {
+        if (statistics.enabled.load(std::memory_order_relaxed))
+        {
+            if (ptr)
+            {
+                statistics.allocation_count.fetch_add(1, std::memory_order_relaxed);
+                statistics.bytes_allocated.fetch_add(count, std::memory_order_relaxed);
+            }
+            else
+            {
+                statistics.failed_allocation_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    inline void record_free() noexcept
+    {
+        if (statistics.enabled.load(std::memory_order_relaxed))
+        {
+            statistics.free_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+using namespace xlang::impl;
+
+XLANG_PAL_EXPORT void* XLANG_CALL xlang_mem_alloc(size_t count) XLANG_NOEXCEPT
+{
+    // Zero byte allocations must still return a unique, valid pointer.
+    if (count == 0)
+    {
+        count = 1;
+    }
+
+    void* result{};
+    if (auto const allocator = current_allocator.load(std::memory_order_acquire))
+    {
+        result = allocator->alloc(allocator->context, count);
+    }
+    else
+    {
+        result = platform_mem_alloc(count);
+    }
+
+    record_alloc(result, count);
+    return result;
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_free(void* ptr) XLANG_NOEXCEPT
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    record_free();
+
+    if (auto const allocator = current_allocator.load(std::memory_order_acquire))
+    {
+        allocator->free(allocator->context, ptr);
+    }
+    else
+    {
+        platform_mem_free(ptr);
+    }
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_free_sized(void* ptr, size_t count) XLANG_NOEXCEPT
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    record_free();
+
+    if (auto const allocator = current_allocator.load(std::memory_order_acquire))
+    {
+        if (allocator->free_sized)
+        {
+            allocator->free_sized(allocator->context, ptr, count == 0 ? 1 : count);
+        }
+        else
+        {
+            allocator->free(allocator->context, ptr);
+        }
+    }
+    else
+    {
+        platform_mem_free(ptr);
+    }
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_mem_set_allocator(
+    xlang_mem_allocator const* allocator
+) XLANG_NOEXCEPT
+try
+{
+    if (!allocator)
+    {
+        current_allocator.store(nullptr, std::memory_order_release);
+        return nullptr;
+    }
+
+    if (!allocator->alloc || !allocator->free)
+    {
+        xlang::throw_result(xlang_result::invalid_arg);
+    }
+
+    // Blocks are always returned to the allocator that produced them, so swapping allocators is only
+    // supported during startup, before other threads use the PAL.
+    current_allocator.store(nullptr, std::memory_order_release);
+    installed_allocator = *allocator;
+    current_allocator.store(&installed_allocator, std::memory_order_release);
+    return nullptr;
+}
+catch (...)
+{
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_enable_statistics(bool enable) XLANG_NOEXCEPT
+{
+    statistics.enabled.store(enable, std::memory_order_relaxed);
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_get_statistics(xlang_mem_statistics* result) XLANG_NOEXCEPT
+{
+    result->allocation_count = statistics.allocation_count.load(std::memory_order_relaxed);
+    result->failed_allocation_count = statistics.failed_allocation_count.load(std::memory_order_relaxed);
+    result->free_count = statistics.free_count.load(std::memory_order_relaxed);
+    result->bytes_allocated = statistics.bytes_allocated.load(std::memory_order_relaxed);
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_reset_statistics() XLANG_NOEXCEPT
+{
+    statistics.allocation_count.store(0, std::memory_order_relaxed);
+    statistics.failed_allocation_count.store(0, std::memory_order_relaxed);
+    statistics.free_count.store(0, std::memory_order_relaxed);
+    statistics.bytes_allocated.store(0, std::memory_order_relaxed);
+}
@@ -1,16 +1,35 @@
 #pragma once
 
 #include "pal.h"
+#include <string>
 #include <string_view>
 
 namespace xlang::impl
 {
 #if XLANG_PLATFORM_WINDOWS
     using filesystem_char_type = char16_t;
+    inline constexpr filesystem_char_type path_separator{ u'\\' };
+    inline constexpr filesystem_char_type path_list_separator{ u';' };
+
+    inline constexpr bool is_relative_path(std::basic_string_view<filesystem_char_type> path) noexcept
+    {
+        bool const rooted = !path.empty() && (path[0] == u'\\' || path[0] == u'/');
+        bool const has_drive = path.size() > 1 && path[1] == u':';
+        return !rooted && !has_drive;
+    }
 #else
     using filesystem_char_type = char;
+    inline constexpr filesystem_char_type path_separator{ '/' };
+    inline constexpr filesystem_char_type path_list_separator{ ':' };
+
+    inline constexpr bool is_relative_path(std::basic_string_view<filesystem_char_type> path) noexcept
+    {
+        return path.empty() || path[0] != '/';
+    }
 #endif
 
+    using filesystem_string = std::basic_string<filesystem_char_type>;
+
     inline constexpr std::string_view activation_fn_name{ "xlang_lib_get_activation_factory" };
 
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
@@ -19,6 +38,22 @@ namespace xlang::impl
     xlang_pfn_lib_get_activation_factory try_get_activation_func(
         std::basic_string_view<char16_t> module_namespace);
 
+    // Loads the module at the given path, without searching, and returns its activation function.
+    xlang_pfn_lib_get_activation_factory try_get_activation_func_from_path(
+        filesystem_string const& module_path);
+
+    // Appends the platform's module file name for a namespace, e.g. "libFoo.Bar.so" or "Foo.Bar.dll".
+    void append_module_file_name(
+        filesystem_string& path,
+        std::basic_string_view<filesystem_char_type> module_namespace);
+
+    bool try_get_environment_variable(std::string_view name, filesystem_string& value);
+
+    bool try_read_file(filesystem_string const& path, std::string& contents);
+
+    // Returns the path unchanged if it is absolute, and otherwise resolves it against the current directory.
+    filesystem_string get_absolute_path(filesystem_string const& path);
+
     template <typename char_type>
     inline constexpr std::basic_string_view<char_type> enclosing_namespace(std::basic_string_view<char_type> str) noexcept
     {
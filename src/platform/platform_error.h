@@ -0,0 +1,10 @@
+#pragma once
+
+#include "pal.h"
+
+namespace xlang::impl
+{
+    // Default unwinder used for execution traces when no unwinder has been supplied. Frames of the unwinder
+    // itself are skipped.
+    uint32_t XLANG_CALL platform_capture_stack(void* context, void** frames, uint32_t max_frame_count) noexcept;
+}
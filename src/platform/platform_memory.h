@@ -0,0 +1,10 @@
+#pragma once
+
+#include "pal.h"
+
+namespace xlang::impl
+{
+    // Default allocator used by xlang_mem_alloc / xlang_mem_free when no allocator has been installed.
+    void* platform_mem_alloc(size_t count) noexcept;
+    void platform_mem_free(void* ptr) noexcept;
+}
@@ -182,6 +182,31 @@ extern "C"
         char reserved2[16];
     };
 
+    // A string that is never freed, such as one built at compile time by xlang::static_hstring. The PAL never
+    // writes to it, so it may be placed in read-only memory, and duplicating or deleting it does nothing. The flags
+    // must be xlang_static_string_flags, and utf16 must point to an xlang_static_string_utf16 holding the same
+    // string in UTF-16. Both buffers are null terminated and lengths don't include the terminator.
+    struct xlang_static_string_header
+    {
+        uint32_t flags;
+        uint32_t length;
+        union
+        {
+            void const* utf16;
+            char reserved[8];
+        };
+        xlang_char8 const* buffer;
+    };
+
+    // Immediately followed by the UTF-16 buffer.
+    struct xlang_static_string_utf16
+    {
+        int32_t reserved;
+        uint32_t length;
+    };
+
+    inline constexpr uint32_t xlang_static_string_flags{ 0x22 };
+
 #ifdef __cplusplus
     enum class xlang_string_encoding
     {
@@ -199,6 +224,13 @@ extern "C"
     };
 #endif
 
+    // Tracks progress through a string that is being copied in chunks. Zero-initialize before the first copy.
+    struct xlang_string_cursor
+    {
+        uint32_t source_position;
+        uint32_t target_position;
+    };
+
 #ifdef __cplusplus
     enum class xlang_result : uint32_t
     {
@@ -233,6 +265,20 @@ extern "C"
     };
 #endif
 
+#ifdef __cplusplus
+    enum class xlang_error_origination : uint32_t
+    {
+        rich = 0,
+        lightweight = 1
+    };
+#else
+    enum xlang_error_origination
+    {
+        xlang_error_origination_rich = 0,
+        xlang_error_origination_lightweight = 1
+    };
+#endif
+
     struct XLANG_NOVTABLE xlang_error_info : xlang_unknown
     {
         virtual void GetError(xlang_result* error) XLANG_NOEXCEPT = 0;
@@ -251,11 +297,70 @@ extern "C"
     };
     inline constexpr xlang_guid xlang_error_info_guid{ 0xadf906fb, 0x11ac, 0x49ec, { 0x8d, 0xfd, 0x64, 0xc2, 0x6d, 0x8, 0x87, 0xb0 } };
 
+    // Execution traces captured by the PAL when errors are originated or propagated.
+    struct XLANG_NOVTABLE xlang_execution_trace : xlang_unknown
+    {
+        virtual void GetFrames(void* const** frames, uint32_t* frame_count) XLANG_NOEXCEPT = 0;
+    };
+    inline constexpr xlang_guid xlang_execution_trace_guid{ 0x50bf2dad, 0x1515, 0x4038, { 0x8b, 0x4c, 0xb4, 0x1d, 0xf8, 0x4d, 0x0a, 0xc4 } };
+
+    // Fills frames with up to max_frame_count return addresses, innermost first, and returns the number written.
+    typedef uint32_t(XLANG_CALL * xlang_pfn_capture_stack)(void* context, void** frames, uint32_t max_frame_count);
+
+    struct xlang_error_trace_options
+    {
+        xlang_pfn_capture_stack capture_stack;
+        void* context;
+        uint32_t max_frame_count;
+        uint32_t sample_interval;
+        uint32_t max_traces_per_second;
+    };
+
+    struct xlang_error_statistics
+    {
+        uint64_t originated_count;
+        uint64_t traced_count;
+    };
+
+    typedef void* (XLANG_CALL * xlang_pfn_mem_alloc)(void* context, size_t count);
+    typedef void (XLANG_CALL * xlang_pfn_mem_free)(void* context, void* ptr);
+    typedef void (XLANG_CALL * xlang_pfn_mem_free_sized)(void* context, void* ptr, size_t count);
+
+    // Allocator callbacks backing xlang_mem_alloc / xlang_mem_free. free_sized is optional; when
+    // present, the PAL calls it instead of free whenever the size of the block is known.
+    struct xlang_mem_allocator
+    {
+        void* context;
+        xlang_pfn_mem_alloc alloc;
+        xlang_pfn_mem_free free;
+        xlang_pfn_mem_free_sized free_sized;
+    };
+
+    struct xlang_mem_statistics
+    {
+        uint64_t allocation_count;
+        uint64_t failed_allocation_count;
+        uint64_t free_count;
+        uint64_t bytes_allocated;
+    };
+
     // Function declarations
     XLANG_PAL_EXPORT void* XLANG_CALL xlang_mem_alloc(size_t count) XLANG_NOEXCEPT;
 
     XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_free(void* ptr) XLANG_NOEXCEPT;
 
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_free_sized(void* ptr, size_t count) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_mem_set_allocator(
+        xlang_mem_allocator const* allocator
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_enable_statistics(bool enable) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_get_statistics(xlang_mem_statistics* statistics) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_mem_reset_statistics() XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_create_string_utf8(
         xlang_char8 const* source_string,
         uint32_t length,
@@ -304,6 +409,32 @@ extern "C"
         uint32_t* length
     ) XLANG_NOEXCEPT;
 
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_string_length_utf8(
+        xlang_string string,
+        uint32_t* length
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_string_length_utf16(
+        xlang_string string,
+        uint32_t* length
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_copy_string_utf8(
+        xlang_string string,
+        xlang_string_cursor* cursor,
+        xlang_char8* buffer,
+        uint32_t buffer_length,
+        uint32_t* copied_length
+    ) XLANG_NOEXCEPT;
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_copy_string_utf16(
+        xlang_string string,
+        xlang_string_cursor* cursor,
+        char16_t* buffer,
+        uint32_t buffer_length,
+        uint32_t* copied_length
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_set_string_cache_threshold(uint32_t length) XLANG_NOEXCEPT;
+
     XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_preallocate_string_buffer_utf8(
         uint32_t length,
         xlang_char8** char_buffer,
@@ -327,8 +458,41 @@ extern "C"
         void** factory
     ) XLANG_NOEXCEPT;
 
+    XLANG_PAL_EXPORT xlang_result XLANG_CALL xlang_try_get_activation_factory(
+        xlang_string class_name,
+        xlang_guid const& iid,
+        void** factory
+    ) XLANG_NOEXCEPT;
+
     typedef xlang_result(XLANG_CALL * xlang_pfn_lib_get_activation_factory)(xlang_string, xlang_guid const&, void **);
 
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_invalidate_activation_cache(
+        xlang_string namespace_name
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_add_module_search_path(
+        xlang_string directory
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_remove_module_search_path(
+        xlang_string directory
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_register_activation_module(
+        xlang_string namespace_name,
+        xlang_string module_path,
+        bool preload
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_unregister_activation_module(
+        xlang_string namespace_name
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_load_activation_manifest(
+        xlang_string manifest_path,
+        bool preload
+    ) XLANG_NOEXCEPT;
+
 #ifdef __cplusplus
     [[nodiscard]] XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_originate_error(
         xlang_result error,
@@ -347,6 +511,19 @@ extern "C"
         xlang_unknown* language_information) XLANG_NOEXCEPT;
 #endif
 
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_set_error_origination(xlang_error_origination origination) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_set_error_trace_options(
+        xlang_error_trace_options const* options
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_error_statistics(
+        xlang_result error,
+        xlang_error_statistics* statistics
+    ) XLANG_NOEXCEPT;
+
+    XLANG_PAL_EXPORT void XLANG_CALL xlang_reset_error_statistics() XLANG_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -82,6 +82,41 @@ namespace xlang::impl
         }
     }
 
+    template <typename char_type>
+    uint32_t get_string_length(xlang_string string)
+    {
+        if (string)
+        {
+            return from_handle(string)->get_length_as<char_type>();
+        }
+        return 0;
+    }
+
+    template <typename char_type>
+    uint32_t copy_string(
+        xlang_string string,
+        xlang_string_cursor* cursor,
+        char_type* buffer,
+        uint32_t buffer_length
+    )
+    {
+        if (!cursor || (!buffer && buffer_length != 0))
+        {
+            xlang::throw_result(xlang_result::pointer);
+        }
+
+        if (string)
+        {
+            return from_handle(string)->copy_buffer(*cursor, buffer, buffer_length);
+        }
+
+        if (cursor->source_position != 0)
+        {
+            xlang::throw_result(xlang_result::invalid_arg);
+        }
+        return 0;
+    }
+
     template <typename char_type>
     xlang_string_buffer preallocate_string_buffer(
         uint32_t length,
@@ -264,6 +299,77 @@ catch (...)
     return xlang::to_result();
 }
 
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_string_length_utf8(
+    xlang_string string,
+    uint32_t* length
+) XLANG_NOEXCEPT
+try
+{
+    *length = xlang::impl::get_string_length<xlang_char8>(string);
+    return nullptr;
+}
+catch (...)
+{
+    *length = 0;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_get_string_length_utf16(
+    xlang_string string,
+    uint32_t* length
+) XLANG_NOEXCEPT
+try
+{
+    *length = xlang::impl::get_string_length<char16_t>(string);
+    return nullptr;
+}
+catch (...)
+{
+    *length = 0;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_copy_string_utf8(
+    xlang_string string,
+    xlang_string_cursor* cursor,
+    xlang_char8* buffer,
+    uint32_t buffer_length,
+    uint32_t* copied_length
+) XLANG_NOEXCEPT
+try
+{
+    *copied_length = xlang::impl::copy_string(string, cursor, buffer, buffer_length);
+    return nullptr;
+}
+catch (...)
+{
+    *copied_length = 0;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_copy_string_utf16(
+    xlang_string string,
+    xlang_string_cursor* cursor,
+    char16_t* buffer,
+    uint32_t buffer_length,
+    uint32_t* copied_length
+) XLANG_NOEXCEPT
+try
+{
+    *copied_length = xlang::impl::copy_string(string, cursor, buffer, buffer_length);
+    return nullptr;
+}
+catch (...)
+{
+    *copied_length = 0;
+    return xlang::to_result();
+}
+
+XLANG_PAL_EXPORT void XLANG_CALL xlang_set_string_cache_threshold(uint32_t length) XLANG_NOEXCEPT
+{
+    string_base::set_cache_threshold(length);
+}
+
 XLANG_PAL_EXPORT xlang_error_info* XLANG_CALL xlang_preallocate_string_buffer_utf8(
     uint32_t length,
     xlang_char8** char_buffer,
@@ -6,6 +6,11 @@ namespace xlang::impl
 {
     void string_base::release_base() noexcept
     {
+        if (this->is_static())
+        {
+            return;
+        }
+
         if (this->is_reference())
         {
             static_cast<string_reference*>(this)->release();
@@ -18,18 +23,16 @@ namespace xlang::impl
 
     string_base* string_base::duplicate_base()
     {
+        if (this->is_static())
+        {
+            return this;
+        }
+
         if (this->is_reference())
         {
-            auto str = static_cast<string_reference*>(this);
-            // This is a string reference. Create a ref counted string and return it.
-            if (is_utf8())
-            {
-                return heap_string::create(str->get_buffer<xlang_char8>(), str->get_length(), str->get_alternate());
-            }
-            else
-            {
-                return heap_string::create(str->get_buffer<char16_t>(), str->get_length(), str->get_alternate());
-            }
+            // This is a string reference. Callees often store the same parameter more than once, so the
+            // reference remembers its ref counted copy and hands it out again for later duplicates.
+            return static_cast<string_reference*>(this)->promote();
         }
         else
         {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <type_traits>
 #include <algorithm>
 #include "pal_internal.h"
@@ -14,6 +15,7 @@ namespace xlang::impl
     {
         none = 0x0000,         // None
         is_reference = 0x0001, // Whether this is a "fast" string
+        is_static = 0x0002,    // Never freed, see xlang_static_string_header
         is_utf8 = 0x0020,      // Character pointer is UTF-8 data
 
         is_preallocated_string_buffer = 0xF8B10000,
@@ -53,8 +55,14 @@ namespace xlang::impl
         return static_cast<string_flags>(~static_cast<int_t>(arg));
     }
 
+    // A string reference that has been duplicated keeps the heap_string it was copied into in its alternate_form
+    // slot, tagged with this bit. Later duplicates of the same reference share that copy, and the cached alternate
+    // encoding is owned by the heap_string from then on.
+    inline constexpr uintptr_t promoted_string_tag{ 0x1 };
+
     inline constexpr string_flags all_valid_flags =
         string_flags::is_reference |
+        string_flags::is_static |
         string_flags::is_utf8 |
         string_flags::reserved_for_preallocated_string_buffer;
 
@@ -83,6 +91,14 @@ namespace xlang::impl
         };
     };
 
+    // Static strings are laid out by the client, see xlang_static_string_header.
+    static_assert(sizeof(xlang_static_string_header) == sizeof(string_storage_base), "xlang_static_string_header must be same size as string_storage_base");
+    static_assert(offsetof(xlang_static_string_header, length) == offsetof(string_storage_base, length_), "Static string length offset mismatch");
+    static_assert(offsetof(xlang_static_string_header, utf16) == offsetof(string_storage_base, alternate_form), "Static string alternate offset mismatch");
+    static_assert(offsetof(xlang_static_string_header, buffer) == offsetof(string_storage_base, string_ref), "Static string buffer offset mismatch");
+    static_assert(sizeof(xlang_static_string_utf16) == sizeof(cache_string), "xlang_static_string_utf16 must be same size as cache_string");
+    static_assert(static_cast<string_flags>(xlang_static_string_flags) == (string_flags::is_static | string_flags::is_utf8), "Static string flags mismatch");
+
     // String objects are represented by a set of classes that all derive from string_base. The
     // data for string_base (the common string header data) is defined separately in the
     // string_storage_base struct for debugging and testing purposes. Aside from those cases, all
@@ -114,7 +130,18 @@ namespace xlang::impl
         template <typename char_type>
         char_type const* get_buffer() const noexcept;
 
+        // Length and chunked copies in either encoding. Unlike ensure_buffer, these only attach an alternate
+        // representation if the string is no longer than the cache threshold.
+        template <typename char_type>
+        uint32_t get_length_as();
+
+        template <typename char_type>
+        uint32_t copy_buffer(xlang_string_cursor& cursor, char_type* buffer, uint32_t buffer_length);
+
+        static void set_cache_threshold(uint32_t length) noexcept;
+
         bool is_reference() const noexcept;
+        bool is_static() const noexcept;
         bool is_preallocated_buffer() const noexcept;
         bool is_utf8() const noexcept;
         bool has_alternate() const noexcept;
@@ -143,9 +170,22 @@ namespace xlang::impl
         template <typename alternate_type>
         alternate_type* set_alternate_ptr(alternate_type* new_alternate) noexcept;
 
+        // Get or set the string a reference was promoted to. Setting only succeeds if the alternate_form slot still
+        // holds expected_alternate.
+        string_base* get_promoted_ptr() const noexcept;
+        bool set_promoted_ptr(cache_string* expected_alternate, string_base* promoted) noexcept;
+
     private:
         template <typename my_char_type, typename requested_char_type>
         std::basic_string_view<requested_char_type> ensure_buffer_impl();
+
+        template <typename my_char_type, typename requested_char_type>
+        uint32_t get_length_as_impl();
+
+        template <typename my_char_type, typename requested_char_type>
+        uint32_t copy_buffer_impl(xlang_string_cursor& cursor, requested_char_type* buffer, uint32_t buffer_length);
+
+        inline static std::atomic<uint32_t> cache_threshold{ 0 };
     };
 
     // This class is a wrapper, need to be able to up-cast safely, which means layout can't change.
@@ -167,6 +207,11 @@ namespace xlang::impl
         return (flags & string_flags::is_reference) != string_flags::none;
     }
 
+    inline bool string_base::is_static() const noexcept
+    {
+        return (flags & string_flags::is_static) != string_flags::none;
+    }
+
     inline bool string_base::is_preallocated_buffer() const noexcept
     {
         return (flags & string_flags::reserved_for_preallocated_string_buffer) == string_flags::is_preallocated_string_buffer;
@@ -204,15 +249,42 @@ namespace xlang::impl
         flags = preserved;
     }
 
+    inline string_base* string_base::get_promoted_ptr() const noexcept
+    {
+        auto const value = reinterpret_cast<uintptr_t>(this->alternate_form.load());
+        if ((value & promoted_string_tag) != 0)
+        {
+            return reinterpret_cast<string_base*>(value & ~promoted_string_tag);
+        }
+        return nullptr;
+    }
+
+    inline bool string_base::set_promoted_ptr(cache_string* expected_alternate, string_base* promoted) noexcept
+    {
+        XLANG_ASSERT(is_reference());
+        XLANG_ASSERT((reinterpret_cast<uintptr_t>(promoted) & promoted_string_tag) == 0);
+        void* expected = expected_alternate;
+        void* const tagged = reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(promoted) | promoted_string_tag);
+        return alternate_form.compare_exchange_strong(expected, tagged);
+    }
+
     template <typename alternate_type>
     inline alternate_type const* string_base::get_alternate_ptr() const noexcept
     {
+        if (string_base const* promoted = get_promoted_ptr())
+        {
+            return promoted->get_alternate_ptr<alternate_type>();
+        }
         return reinterpret_cast<alternate_type const*>(this->alternate_form.load());
     }
 
     template <typename alternate_type>
     inline alternate_type* string_base::get_alternate_ptr() noexcept
     {
+        if (string_base* promoted = get_promoted_ptr())
+        {
+            return promoted->get_alternate_ptr<alternate_type>();
+        }
         return reinterpret_cast<alternate_type*>(this->alternate_form.load());
     }
 
@@ -225,6 +297,12 @@ namespace xlang::impl
         void* expected = nullptr;
         bool result = alternate_form.compare_exchange_strong(expected, new_alternate);
 
+        // A promoted string reference delegates its alternate to the heap_string it was promoted to.
+        if (!result && (reinterpret_cast<uintptr_t>(expected) & promoted_string_tag) != 0)
+        {
+            return get_promoted_ptr()->set_alternate_ptr<alternate_type>(new_alternate);
+        }
+
         // result has the old value now. If it was null, we set the new one. Otherwise result is still the current
         // alternate.
         return result ? new_alternate : reinterpret_cast<alternate_type*>(expected);
@@ -266,4 +344,102 @@ namespace xlang::impl
             return { alternate->get_buffer<requested_char_type>(), alternate->get_length() };
         }
     }
+
+    inline void string_base::set_cache_threshold(uint32_t length) noexcept
+    {
+        cache_threshold.store(length, std::memory_order_relaxed);
+    }
+
+    template <typename char_type>
+    inline uint32_t string_base::get_length_as()
+    {
+        if (is_utf8())
+        {
+            return get_length_as_impl<xlang_char8, char_type>();
+        }
+        else
+        {
+            return get_length_as_impl<char16_t, char_type>();
+        }
+    }
+
+    template <typename my_char_type, typename requested_char_type>
+    inline uint32_t string_base::get_length_as_impl()
+    {
+        if constexpr (std::is_same_v<my_char_type, requested_char_type>)
+        {
+            return get_length();
+        }
+        else
+        {
+            if (cache_string const* alternate = get_alternate_ptr<cache_string>())
+            {
+                return alternate->get_length();
+            }
+            if (get_length() <= cache_threshold.load(std::memory_order_relaxed))
+            {
+                return static_cast<uint32_t>(ensure_buffer_impl<my_char_type, requested_char_type>().size());
+            }
+            return get_converted_length(std::basic_string_view<my_char_type>{ get_buffer<my_char_type>(), get_length() });
+        }
+    }
+
+    template <typename char_type>
+    inline uint32_t string_base::copy_buffer(xlang_string_cursor& cursor, char_type* buffer, uint32_t buffer_length)
+    {
+        if (is_utf8())
+        {
+            return copy_buffer_impl<xlang_char8, char_type>(cursor, buffer, buffer_length);
+        }
+        else
+        {
+            return copy_buffer_impl<char16_t, char_type>(cursor, buffer, buffer_length);
+        }
+    }
+
+    template <typename my_char_type, typename requested_char_type>
+    inline uint32_t string_base::copy_buffer_impl(xlang_string_cursor& cursor, requested_char_type* buffer, uint32_t buffer_length)
+    {
+        if (cursor.source_position > get_length())
+        {
+            throw_result(xlang_result::invalid_arg);
+        }
+
+        std::basic_string_view<my_char_type> const source{ get_buffer<my_char_type>() + cursor.source_position, get_length() - cursor.source_position };
+
+        // The chunk is always measured on the original representation, so the cursor stays consistent even if
+        // another thread attaches an alternate representation between calls.
+        string_chunk const chunk = get_chunk<my_char_type, requested_char_type>(source, buffer_length);
+        if (chunk.source_length == 0 && !source.empty())
+        {
+            throw_result(xlang_result::invalid_arg, "Insufficient buffer size");
+        }
+
+        if constexpr (std::is_same_v<my_char_type, requested_char_type>)
+        {
+            std::copy_n(source.data(), chunk.target_length, buffer);
+        }
+        else
+        {
+            cache_string const* alternate = get_alternate_ptr<cache_string>();
+            if (!alternate && get_length() <= cache_threshold.load(std::memory_order_relaxed))
+            {
+                ensure_buffer_impl<my_char_type, requested_char_type>();
+                alternate = get_alternate_ptr<cache_string>();
+            }
+
+            if (alternate)
+            {
+                std::copy_n(alternate->get_buffer<requested_char_type>() + cursor.target_position, chunk.target_length, buffer);
+            }
+            else if (chunk.target_length != 0)
+            {
+                convert_string(source.substr(0, chunk.source_length), buffer, chunk.target_length);
+            }
+        }
+
+        cursor.source_position += chunk.source_length;
+        cursor.target_position += chunk.target_length;
+        return chunk.target_length;
+    }
 }
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <stdint.h>
+#include <new>
+#include "pal_internal.h"
+
+namespace xlang::impl
+{
+    // Recycles the blocks holding short heap strings. A freed block is kept on a per-thread free list for its size
+    // class and handed to the next short string created on that thread, so that creating and destroying short
+    // strings doesn't go to the allocator. Longer strings, and blocks freed once a list is full, are allocated and
+    // freed with xlang_mem_alloc and xlang_mem_free as before.
+    struct string_block_cache
+    {
+        static constexpr uint32_t granularity = 16;
+        static constexpr uint32_t size_classes = 4;
+        static constexpr uint32_t max_cached = 256;
+
+        static void* allocate(uint32_t size) noexcept
+        {
+            uint32_t const index = size_class(size);
+
+            if (index < size_classes)
+            {
+                // Always allocate the whole size class. The block may be freed on a thread whose cache is alive and
+                // handed to any later allocation of that class.
+                size = (index + 1) * granularity;
+
+                if (!t_destroyed)
+                {
+                    free_list& list = local().lists[index];
+
+                    if (list.head)
+                    {
+                        node* const result = list.head;
+                        list.head = result->next;
+                        --list.count;
+                        return result;
+                    }
+                }
+            }
+
+            return xlang_mem_alloc(size);
+        }
+
+        // The size may be smaller than the block, as it is for a preallocated buffer promoted to a shorter string.
+        // Blocks are only ever reused for strings no larger than the size they were freed with.
+        static void deallocate(void* block, uint32_t const size) noexcept
+        {
+            uint32_t const index = size_class(size);
+
+            if (index < size_classes && !t_destroyed)
+            {
+                free_list& list = local().lists[index];
+
+                if (list.count < max_cached)
+                {
+                    list.head = new (block) node{ list.head };
+                    ++list.count;
+                    return;
+                }
+            }
+
+            xlang_mem_free(block);
+        }
+
+    private:
+
+        struct node
+        {
+            node* next;
+        };
+
+        struct free_list
+        {
+            node* head{};
+            uint32_t count{};
+        };
+
+        struct cache
+        {
+            ~cache()
+            {
+                t_destroyed = true;
+
+                for (free_list& list : lists)
+                {
+                    while (list.head)
+                    {
+                        node* const next = list.head->next;
+                        xlang_mem_free(list.head);
+                        list.head = next;
+                    }
+                }
+            }
+
+            free_list lists[size_classes];
+        };
+
+        static uint32_t size_class(uint32_t const size) noexcept
+        {
+            return (size + granularity - 1) / granularity - 1;
+        }
+
+        static cache& local() noexcept
+        {
+            static thread_local cache value;
+            return value;
+        }
+
+        // Strings may still be released by other thread_local destructors once the cache is gone.
+        inline static thread_local bool t_destroyed{};
+    };
+}
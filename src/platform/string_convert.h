@@ -4,6 +4,8 @@
 #include <stdint.h>
 #include <optional>
 #include <string_view>
+#include <algorithm>
+#include <type_traits>
 
 namespace xlang::impl
 {
@@ -19,4 +21,64 @@ namespace xlang::impl
         std::basic_string_view<xlang_char8> input_str,
         char16_t* output_buffer,
         uint32_t buffer_size);
-}
\ No newline at end of file
+
+    // Describes the longest prefix of a string that can be written to a buffer without splitting a code point.
+    struct string_chunk
+    {
+        uint32_t source_length;
+        uint32_t target_length;
+    };
+
+    // Only lead code units are inspected. Malformed sequences are measured as if they were well formed and are
+    // subsequently rejected by convert_string.
+    template <typename source_type, typename target_type>
+    inline string_chunk get_chunk(std::basic_string_view<source_type> source, uint32_t buffer_length) noexcept
+    {
+        auto const source_length = static_cast<uint32_t>(source.size());
+        string_chunk result{};
+        while (result.source_length < source_length)
+        {
+            uint32_t source_units{ 1 };
+            uint32_t target_units{ 1 };
+            if constexpr (std::is_same_v<source_type, char16_t>)
+            {
+                char16_t const ch = source[result.source_length];
+                if (0xd800 <= ch && ch < 0xdc00)
+                {
+                    source_units = 2;
+                }
+                source_units = std::min(source_units, source_length - result.source_length);
+                if constexpr (std::is_same_v<target_type, char16_t>)
+                {
+                    target_units = source_units;
+                }
+                else
+                {
+                    target_units = source_units == 2 ? 4 : ch < 0x80 ? 1 : ch < 0x800 ? 2 : 3;
+                }
+            }
+            else
+            {
+                auto const lead = static_cast<uint8_t>(source[result.source_length]);
+                source_units = lead < 0xc0 ? 1 : lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : 4;
+                source_units = std::min(source_units, source_length - result.source_length);
+                if constexpr (std::is_same_v<target_type, xlang_char8>)
+                {
+                    target_units = source_units;
+                }
+                else
+                {
+                    target_units = source_units == 4 ? 2 : 1;
+                }
+            }
+
+            if (buffer_length - result.target_length < target_units)
+            {
+                break;
+            }
+            result.source_length += source_units;
+            result.target_length += target_units;
+        }
+        return result;
+    }
+}
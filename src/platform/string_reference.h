@@ -2,6 +2,7 @@
 
 #include "string_base.h"
 #include "cache_string.h"
+#include "heap_string.h"
 
 namespace xlang::impl
 {
@@ -22,6 +23,9 @@ namespace xlang::impl
 
         void release() noexcept;
 
+        // Copy to a heap_string, or share the copy made by a previous call.
+        heap_string* promote();
+
     private:
         string_reference() = delete;
         ~string_reference() = delete;
@@ -72,10 +76,46 @@ namespace xlang::impl
 
     inline void string_reference::release() noexcept
     {
-        auto alternate = get_alternate();
-        if (alternate)
+        if (auto promoted = get_promoted_ptr())
+        {
+            static_cast<heap_string*>(promoted)->release();
+        }
+        else if (auto alternate = get_alternate())
         {
             alternate->release();
         }
     }
+
+    inline heap_string* string_reference::promote()
+    {
+        while (true)
+        {
+            if (auto promoted = get_promoted_ptr())
+            {
+                auto result = static_cast<heap_string*>(promoted);
+                result->addref();
+                return result;
+            }
+
+            cache_string* alternate = get_alternate();
+            heap_string* result = is_utf8() ?
+                heap_string::create(get_buffer<xlang_char8>(), get_length(), alternate) :
+                heap_string::create(get_buffer<char16_t>(), get_length(), alternate);
+
+            if (set_promoted_ptr(alternate, result))
+            {
+                // The heap_string took its own reference on the alternate, which it now owns. The string reference
+                // keeps the initial reference on the heap_string until it is released.
+                if (alternate)
+                {
+                    alternate->release();
+                }
+                result->addref();
+                return result;
+            }
+
+            // Lost a race with another duplicate, or with the alternate being cached. Try again.
+            result->release();
+        }
+    }
 }
\ No newline at end of file
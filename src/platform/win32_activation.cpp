@@ -1,6 +1,8 @@
 #include "win32_pal_internal.h"
 #include "platform_activation.h"
 #include "string_convert.h"
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <string>
 
@@ -66,4 +68,80 @@ namespace xlang::impl
             return try_get_activation_func({ converted_name.get(), converted_length });
         }
     }
-}
+
+    xlang_pfn_lib_get_activation_factory try_get_activation_func_from_path(
+        std::u16string const& module_path)
+    {
+        HMODULE module = ::LoadLibraryW(reinterpret_cast<wchar_t const*>(module_path.c_str()));
+        if (module)
+        {
+            return reinterpret_cast<xlang_pfn_lib_get_activation_factory>(::GetProcAddress(module, activation_fn_name.data()));
+        }
+        return nullptr;
+    }
+
+    void append_module_file_name(
+        std::u16string& path,
+        std::u16string_view module_namespace)
+    {
+        constexpr auto file_ext{ u".dll"sv };
+        path.reserve(path.size() + module_namespace.size() + file_ext.size());
+        path += module_namespace;
+        path += file_ext;
+    }
+
+    bool try_get_environment_variable(std::string_view name, std::u16string& value)
+    {
+        // Variable names used by the PAL are plain ASCII.
+        std::wstring const wide_name(name.begin(), name.end());
+        DWORD const length = ::GetEnvironmentVariableW(wide_name.c_str(), nullptr, 0);
+        if (length == 0)
+        {
+            return false;
+        }
+
+        value.resize(length);
+        DWORD const copied = ::GetEnvironmentVariableW(wide_name.c_str(), reinterpret_cast<wchar_t*>(value.data()), length);
+        if (copied == 0 || copied >= length)
+        {
+            return false;
+        }
+        value.resize(copied);
+        return true;
+    }
+
+    bool try_read_file(std::u16string const& path, std::string& contents)
+    {
+        std::ifstream file{ reinterpret_cast<wchar_t const*>(path.c_str()), std::ios::in | std::ios::binary };
+        if (!file)
+        {
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+        return !file.bad();
+    }
+
+    std::u16string get_absolute_path(std::u16string const& path)
+    {
+        if (!is_relative_path(path))
+        {
+            return path;
+        }
+
+        auto const wide_path = reinterpret_cast<wchar_t const*>(path.c_str());
+        DWORD const length = ::GetFullPathNameW(wide_path, 0, nullptr, nullptr);
+        if (length == 0)
+        {
+            throw_last_error();
+        }
+
+        std::u16string result(length, u'\0');
+        DWORD const copied = ::GetFullPathNameW(wide_path, length, reinterpret_cast<wchar_t*>(result.data()), nullptr);
+        if (copied == 0 || copied >= length)
+        {
+            throw_last_error();
+        }
+        result.resize(copied);
+        return result;
+    }
+}
\ No newline at end of file
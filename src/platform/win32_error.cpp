@@ -0,0 +1,21 @@
+#include "win32_pal_internal.h"
+#include "platform_error.h"
+
+#if !XLANG_PLATFORM_WINDOWS
+#error "This file is only for targeting Windows"
+#endif
+
+namespace xlang::impl
+{
+    uint32_t XLANG_CALL platform_capture_stack(void*, void** frames, uint32_t max_frame_count) noexcept
+    {
+        // Older versions of Windows reject requests for more than 62 frames in total.
+        constexpr uint32_t max_supported_frame_count{ 62 };
+        constexpr uint32_t skip_count{ 1 };
+        if (max_frame_count > max_supported_frame_count - skip_count)
+        {
+            max_frame_count = max_supported_frame_count - skip_count;
+        }
+        return ::RtlCaptureStackBackTrace(skip_count, max_frame_count, frames, nullptr);
+    }
+}
\ No newline at end of file
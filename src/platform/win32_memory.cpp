@@ -1,19 +1,20 @@
 #include "pal.h"
+#include "platform_memory.h"
 #include <objbase.h>
 
 #if !XLANG_PLATFORM_WINDOWS
 #error "This file is only for targeting Windows"
 #endif
 
-extern "C"
+namespace xlang::impl
 {
-    void* XLANG_CALL xlang_mem_alloc(size_t count) XLANG_NOEXCEPT
+    void* platform_mem_alloc(size_t count) noexcept
     {
         return ::CoTaskMemAlloc(count);
     }
 
-    void XLANG_CALL xlang_mem_free(void* ptr) XLANG_NOEXCEPT
+    void platform_mem_free(void* ptr) noexcept
     {
-        return ::CoTaskMemFree(ptr);
+        ::CoTaskMemFree(ptr);
     }
 }
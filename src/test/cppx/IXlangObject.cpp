@@ -19,3 +19,31 @@ TEST_CASE("IXlangObject")
         REQUIRE(get_HashCode(obj) == get_HashCode(obj2));
     }
 }
+
+TEST_CASE("IXlangObject,hash")
+{
+    struct Object : implements<Object, Windows::Foundation::IXlangObject>
+    {
+    };
+
+    Windows::Foundation::IXlangObject first = make<Object>();
+    Windows::Foundation::IXlangObject second = make<Object>();
+    Windows::Foundation::IUnknown unknown = first;
+
+    std::hash<Windows::Foundation::IXlangObject> const hash;
+    REQUIRE(hash(first) == std::hash<Windows::Foundation::IUnknown>{}(unknown));
+    REQUIRE(hash(first) != hash(second));
+    REQUIRE(hash(nullptr) == hash(nullptr));
+
+    std::unordered_map<object_key<Windows::Foundation::IXlangObject>, int> map;
+    map[first] = 1;
+    map[second] = 2;
+    map[first] = 3;
+
+    REQUIRE(map.size() == 2);
+    REQUIRE(map.at(first) == 3);
+    REQUIRE(map.at(second) == 2);
+    REQUIRE(map.find(make<Object>()) == map.end());
+    REQUIRE(object_key(first).identity() == object_key(unknown.as<Windows::Foundation::IXlangObject>()).identity());
+    REQUIRE(object_key(first).get() == first);
+}
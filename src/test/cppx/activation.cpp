@@ -0,0 +1,59 @@
+#include "pch.h"
+
+using namespace xlang;
+
+namespace
+{
+    struct missing_widget {};
+    struct missing_gadget {};
+}
+
+namespace xlang::impl
+{
+    template <> struct name<missing_widget>
+    {
+        static constexpr auto& value{ u8"NoSuchComponent.Widget" };
+    };
+
+    template <> struct name<missing_gadget>
+    {
+        static constexpr auto& value{ u8"NoSuchComponent.Gadget" };
+    };
+}
+
+TEST_CASE("activation,preload")
+{
+    REQUIRE_THROWS_AS((preload_activation_factories<missing_widget, missing_gadget>()), hresult_error);
+
+    hstring const found[]{ u8"AbiComponent.Widget", u8"AbiComponent.Widget" };
+    preload_activation_factories(found);
+
+    hstring const missing[]{ u8"AbiComponent.Widget", u8"NoSuchComponent.Gadget", u8"NoSuchComponent.Sprocket" };
+    REQUIRE_THROWS_AS(preload_activation_factories(missing), hresult_error);
+
+    // Nothing to resolve.
+    preload_activation_factories<>();
+    preload_activation_factories(array_view<hstring const>{});
+}
+
+TEST_CASE("activation,statistics")
+{
+    reset_factory_cache_statistics();
+
+    // Counting is off by default.
+    REQUIRE_THROWS_AS(get_activation_factory<missing_widget>(), hresult_error);
+    REQUIRE(get_factory_cache_statistics().misses == 0);
+
+    enable_factory_cache_statistics(true);
+
+    // Failures aren't cached, so every attempt is a miss.
+    REQUIRE_THROWS_AS(get_activation_factory<missing_widget>(), hresult_error);
+    REQUIRE_THROWS_AS(get_activation_factory<missing_widget>(), hresult_error);
+    REQUIRE(get_factory_cache_statistics().hits == 0);
+    REQUIRE(get_factory_cache_statistics().misses == 2);
+
+    reset_factory_cache_statistics();
+    REQUIRE(get_factory_cache_statistics().misses == 0);
+
+    enable_factory_cache_statistics(false);
+}
@@ -0,0 +1,36 @@
+#include "pch.h"
+#include <xlang/TestComponent.h>
+
+using namespace xlang;
+
+// Tests the projection cppxlang generates for test_component.il, whose IWidget interface is marked with
+// Foundation.Metadata.BulkPropertiesAttribute.
+
+namespace
+{
+    struct widget : implements<widget, TestComponent::IWidget>
+    {
+        hstring Name() const { return u8"widget"; }
+        int32_t Width() const noexcept { return 640; }
+        int32_t Height() const noexcept { return 480; }
+        bool Enabled() const noexcept { return true; }
+        double Scale() const noexcept { return 1.5; }
+    };
+}
+
+TEST_CASE("bulk_properties,generated")
+{
+    TestComponent::IWidget const object = make<widget>();
+
+    bulk_properties<TestComponent::IWidget> const properties = object.GetBulkProperties();
+    REQUIRE(properties.Name == u8"widget");
+    REQUIRE(properties.Width == 640);
+    REQUIRE(properties.Height == 480);
+    REQUIRE(properties.Enabled);
+    REQUIRE(properties.Scale == 1.5);
+
+    // The generated produce type answers for the bulk properties interface.
+    com_ptr<impl::bulk_properties_abi_t<TestComponent::IWidget>> bulk;
+    REQUIRE(static_cast<impl::unknown_abi*>(get_abi(object))->QueryInterface(impl::bulk_properties_guid<TestComponent::IWidget>::value, bulk.put_void()) == 0);
+    REQUIRE(get_abi(bulk.as<TestComponent::IWidget>()) == get_abi(object));
+}
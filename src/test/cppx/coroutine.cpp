@@ -0,0 +1,805 @@
+#include "pch.h"
+#include <xlang/coroutine.h>
+#include <functional>
+#include <future>
+#include <optional>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+using namespace xlang;
+using namespace std::chrono;
+using namespace std::literals;
+
+namespace
+{
+    // Coroutine return types whose frames come from the frame cache, or straight from the PAL allocator.
+    struct recycled_task {};
+    struct pal_task {};
+
+    template <typename Task>
+    struct task_promise
+    {
+        Task get_return_object() const noexcept
+        {
+            return{};
+        }
+
+        void return_void() const noexcept
+        {
+        }
+
+        std::experimental::suspend_never initial_suspend() const noexcept
+        {
+            return{};
+        }
+
+        std::experimental::suspend_never final_suspend() const noexcept
+        {
+            return{};
+        }
+
+        void unhandled_exception() const noexcept
+        {
+            std::terminate();
+        }
+    };
+
+    struct pal_frame
+    {
+        static void* operator new(size_t size)
+        {
+            return xlang_mem_alloc(size);
+        }
+
+        static void operator delete(void* frame) noexcept
+        {
+            xlang_mem_free(frame);
+        }
+    };
+}
+
+namespace std::experimental
+{
+    template <typename... Args>
+    struct coroutine_traits<recycled_task, Args...>
+    {
+        struct promise_type : task_promise<recycled_task>, xlang::impl::recycled_frame
+        {
+        };
+    };
+
+    template <typename... Args>
+    struct coroutine_traits<pal_task, Args...>
+    {
+        struct promise_type : task_promise<pal_task>, pal_frame
+        {
+        };
+    };
+}
+
+namespace
+{
+    template <typename Task>
+    Task count_up(uint32_t& count)
+    {
+        co_await std::experimental::suspend_never{};
+        ++count;
+    }
+
+    recycled_task hop_and_count(std::atomic<uint32_t>& remaining, std::promise<void>& done)
+    {
+        co_await resume_background();
+
+        if (remaining.fetch_sub(1) == 1)
+        {
+            done.set_value();
+        }
+    }
+
+    uint64_t pal_allocations()
+    {
+        xlang_mem_statistics statistics{};
+        xlang_mem_get_statistics(&statistics);
+        return statistics.allocation_count;
+    }
+
+    fire_and_forget hop_to_background(std::promise<std::thread::id>& result)
+    {
+        co_await resume_background();
+        result.set_value(std::this_thread::get_id());
+    }
+
+    fire_and_forget wait_for(Foundation::TimeSpan duration, std::promise<std::thread::id>& result)
+    {
+        co_await resume_after(duration);
+        result.set_value(std::this_thread::get_id());
+    }
+
+    fire_and_forget hop_repeatedly(uint32_t hops, std::atomic<uint32_t>& remaining, std::promise<void>& done)
+    {
+        for (uint32_t i = 0; i != hops; ++i)
+        {
+            co_await resume_background();
+        }
+
+        if (remaining.fetch_sub(1) == 1)
+        {
+            done.set_value();
+        }
+    }
+
+    // Stands in for a projected async operation, completed explicitly by the test.
+    struct mock_async
+    {
+        enum class status { Started, Completed };
+        using handler_type = std::function<void(mock_async const&, status)>;
+
+        status Status() const
+        {
+            std::lock_guard const guard(m_lock);
+            return m_status;
+        }
+
+        void Completed(handler_type const& handler) const
+        {
+            {
+                std::lock_guard const guard(m_lock);
+
+                if (m_status == status::Started)
+                {
+                    m_completed = handler;
+                    return;
+                }
+            }
+
+            handler(*this, status::Completed);
+        }
+
+        uint32_t GetResults() const
+        {
+            std::lock_guard const guard(m_lock);
+            return m_result;
+        }
+
+        void complete(uint32_t result)
+        {
+            handler_type handler;
+
+            {
+                std::lock_guard const guard(m_lock);
+                m_status = status::Completed;
+                m_result = result;
+                handler = std::move(m_completed);
+            }
+
+            if (handler)
+            {
+                handler(*this, status::Completed);
+            }
+        }
+
+    private:
+
+        mutable std::mutex m_lock;
+        mutable handler_type m_completed;
+        status m_status{ status::Started };
+        uint32_t m_result{};
+    };
+
+    template <typename Executor>
+    fire_and_forget await_result(mock_async const& async, Executor executor, std::atomic<uint32_t>& remaining, std::atomic<uint64_t>& total, std::promise<void>& done)
+    {
+        total += co_await resume_with(async, executor);
+
+        if (remaining.fetch_sub(1) == 1)
+        {
+            done.set_value();
+        }
+    }
+
+    template <typename Executor>
+    fire_and_forget await_thread(mock_async const& async, Executor executor, std::promise<std::pair<uint32_t, std::thread::id>>& result)
+    {
+        uint32_t const value = co_await resume_with(async, executor);
+        result.set_value({ value, std::this_thread::get_id() });
+    }
+
+    template <typename Executor>
+    void await_many(uint32_t count, Executor executor)
+    {
+        std::vector<mock_async> asyncs(count);
+        std::atomic<uint32_t> remaining{ count };
+        std::atomic<uint64_t> total{};
+        std::promise<void> done;
+
+        for (auto const& async : asyncs)
+        {
+            await_result(async, executor, remaining, total, done);
+        }
+
+        for (uint32_t i = 0; i != count; ++i)
+        {
+            asyncs[i].complete(i);
+        }
+
+        done.get_future().get();
+        REQUIRE(total == uint64_t{ count } * (count - 1) / 2);
+    }
+
+#ifndef _WIN32
+    fire_and_forget wait_for_signal(int fd, Foundation::TimeSpan timeout, std::promise<bool>& result)
+    {
+        result.set_value(co_await resume_on_signal(fd, timeout));
+    }
+
+    struct pipe_fds
+    {
+        pipe_fds()
+        {
+            REQUIRE(::pipe(fds) == 0);
+        }
+
+        ~pipe_fds()
+        {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        void signal() const
+        {
+            char const value{};
+            REQUIRE(::write(fds[1], &value, 1) == 1);
+        }
+
+        int fds[2];
+    };
+#endif
+}
+
+TEST_CASE("coroutine,resume_background")
+{
+    std::promise<std::thread::id> result;
+    hop_to_background(result);
+    REQUIRE(result.get_future().get() != std::this_thread::get_id());
+
+    struct context
+    {
+        uint32_t& entered;
+
+        auto operator()() const
+        {
+            ++entered;
+            return entered;
+        }
+    };
+
+    uint32_t entered{};
+    context const value{ entered };
+    std::promise<void> done;
+
+    [](context const& value, std::promise<void>& done) -> fire_and_forget
+    {
+        co_await resume_background(value);
+        done.set_value();
+    }(value, done);
+
+    done.get_future().get();
+    REQUIRE(entered == 1);
+}
+
+TEST_CASE("coroutine,resume_after")
+{
+    {
+        // A zero duration completes without suspending.
+        std::promise<std::thread::id> result;
+        wait_for(0s, result);
+        REQUIRE(result.get_future().get() == std::this_thread::get_id());
+    }
+    {
+        std::promise<std::thread::id> result;
+        auto const start = steady_clock::now();
+        wait_for(50ms, result);
+        REQUIRE(result.get_future().get() != std::this_thread::get_id());
+        REQUIRE(steady_clock::now() - start >= 50ms);
+    }
+    {
+        // Timers complete in deadline order regardless of the order they were started in.
+        std::mutex lock;
+        std::vector<uint32_t> order;
+        std::promise<void> done;
+
+        auto timer = [&](Foundation::TimeSpan duration, uint32_t id) -> fire_and_forget
+        {
+            co_await duration;
+            std::unique_lock guard(lock);
+            order.push_back(id);
+
+            if (order.size() == 3)
+            {
+                guard.unlock();
+                done.set_value();
+            }
+        };
+
+        timer(60ms, 3);
+        timer(20ms, 1);
+        timer(40ms, 2);
+        done.get_future().get();
+        REQUIRE(order == std::vector<uint32_t>{ 1, 2, 3 });
+    }
+}
+
+#ifndef _WIN32
+TEST_CASE("coroutine,resume_on_signal")
+{
+    {
+        pipe_fds fds;
+        std::promise<bool> result;
+        auto future = result.get_future();
+        wait_for_signal(fds.fds[0], {}, result);
+        REQUIRE(future.wait_for(20ms) == std::future_status::timeout);
+        fds.signal();
+        REQUIRE(future.get());
+    }
+    {
+        // Already signaled.
+        pipe_fds fds;
+        fds.signal();
+        std::promise<bool> result;
+        wait_for_signal(fds.fds[0], 1s, result);
+        REQUIRE(result.get_future().get());
+    }
+    {
+        pipe_fds fds;
+        std::promise<bool> result;
+        auto const start = steady_clock::now();
+        wait_for_signal(fds.fds[0], 30ms, result);
+        REQUIRE(!result.get_future().get());
+        REQUIRE(steady_clock::now() - start >= 30ms);
+    }
+    {
+        // Waits on several file descriptors complete independently.
+        pipe_fds first;
+        pipe_fds second;
+        std::promise<bool> first_result;
+        std::promise<bool> second_result;
+        auto first_future = first_result.get_future();
+        auto second_future = second_result.get_future();
+        wait_for_signal(first.fds[0], {}, first_result);
+        wait_for_signal(second.fds[0], {}, second_result);
+        second.signal();
+        REQUIRE(second_future.get());
+        REQUIRE(first_future.wait_for(20ms) == std::future_status::timeout);
+        first.signal();
+        REQUIRE(first_future.get());
+    }
+}
+#endif
+
+TEST_CASE("coroutine,resume_background,concurrent")
+{
+    constexpr uint32_t coroutines = 64;
+    std::atomic<uint32_t> remaining{ coroutines };
+    std::promise<void> done;
+
+    for (uint32_t i = 0; i != coroutines; ++i)
+    {
+        hop_repeatedly(1000, remaining, done);
+    }
+
+    done.get_future().get();
+    REQUIRE(remaining == 0);
+}
+
+TEST_CASE("coroutine,resume_with")
+{
+    {
+        // Already completed.
+        mock_async async;
+        async.complete(1);
+        std::promise<std::pair<uint32_t, std::thread::id>> result;
+        await_thread(async, impl::inline_executor{}, result);
+        REQUIRE(result.get_future().get() == std::pair{ 1u, std::this_thread::get_id() });
+    }
+    {
+        // Resumes on the thread that completes the async object.
+        mock_async async;
+        std::promise<std::pair<uint32_t, std::thread::id>> result;
+        auto future = result.get_future();
+        await_thread(async, impl::inline_executor{}, result);
+        REQUIRE(future.wait_for(0s) == std::future_status::timeout);
+
+        std::thread::id completing_thread;
+        std::thread([&]
+        {
+            completing_thread = std::this_thread::get_id();
+            async.complete(2);
+        }).join();
+
+        REQUIRE(future.get() == std::pair{ 2u, completing_thread });
+    }
+#ifndef _WIN32
+    {
+        mock_async async;
+        std::promise<std::pair<uint32_t, std::thread::id>> result;
+        await_thread(async, background_executor{}, result);
+        async.complete(3);
+        auto const [value, thread] = result.get_future().get();
+        REQUIRE(value == 3);
+        REQUIRE(thread != std::this_thread::get_id());
+    }
+#endif
+}
+
+TEST_CASE("coroutine,resume_with,concurrent")
+{
+    // Many pending awaits don't need a thread each.
+    await_many(10000, impl::inline_executor{});
+#ifndef _WIN32
+    await_many(10000, background_executor{});
+#endif
+}
+
+TEST_CASE("coroutine,frame_cache")
+{
+    {
+        void* const first = impl::frame_cache::allocate(100);
+        impl::frame_cache::deallocate(first, 100);
+
+        // Sizes in the same size class share frames.
+        void* const second = impl::frame_cache::allocate(120);
+        REQUIRE(first == second);
+
+        void* const third = impl::frame_cache::allocate(120);
+        REQUIRE(third != second);
+
+        impl::frame_cache::deallocate(second, 120);
+        impl::frame_cache::deallocate(third, 120);
+    }
+
+    xlang_mem_enable_statistics(true);
+
+    {
+        // Large frames aren't cached.
+        xlang_mem_reset_statistics();
+        impl::frame_cache::deallocate(impl::frame_cache::allocate(4096), 4096);
+        impl::frame_cache::deallocate(impl::frame_cache::allocate(4096), 4096);
+        REQUIRE(pal_allocations() == 2);
+    }
+    {
+        uint32_t count{};
+        count_up<recycled_task>(count);
+        xlang_mem_reset_statistics();
+
+        for (uint32_t i = 0; i != 1000; ++i)
+        {
+            count_up<recycled_task>(count);
+        }
+
+        REQUIRE(count == 1001);
+        REQUIRE(pal_allocations() == 0);
+    }
+    {
+        // Frames freed on another thread are cached by that thread.
+        constexpr uint32_t coroutines = 100;
+        std::atomic<uint32_t> remaining{ coroutines };
+        std::promise<void> done;
+
+        for (uint32_t i = 0; i != coroutines; ++i)
+        {
+            hop_and_count(remaining, done);
+        }
+
+        done.get_future().get();
+        REQUIRE(remaining == 0);
+    }
+
+    xlang_mem_enable_statistics(false);
+}
+
+TEST_CASE("coroutine,cancellation")
+{
+    {
+        cancellation_token token;
+        REQUIRE(!token.can_be_canceled());
+        REQUIRE(!token.is_canceled());
+    }
+    {
+        cancellation_source source;
+        auto const token = source.token();
+        REQUIRE(token.can_be_canceled());
+        REQUIRE(!token.is_canceled());
+
+        uint32_t first{};
+        uint32_t second{};
+        uint32_t removed{};
+
+        cancellation_callback callback_first{ token, [&] { ++first; } };
+        cancellation_callback callback_second{ token, [&] { ++second; } };
+
+        {
+            cancellation_callback callback_removed{ token, [&] { ++removed; } };
+        }
+
+        REQUIRE(source.cancel());
+        REQUIRE(!source.cancel());
+        REQUIRE(token.is_canceled());
+        REQUIRE(source.is_canceled());
+        REQUIRE(first == 1);
+        REQUIRE(second == 1);
+        REQUIRE(removed == 0);
+
+        // Callbacks registered once canceled run right away.
+        uint32_t late{};
+        cancellation_callback callback_late{ token, [&] { ++late; } };
+        REQUIRE(late == 1);
+    }
+    {
+        // A callback may unregister itself while running.
+        cancellation_source source;
+        std::optional<cancellation_callback<std::function<void()>>> callback;
+        uint32_t count{};
+
+        callback.emplace(source.token(), [&]
+        {
+            ++count;
+            callback.reset();
+        });
+
+        source.cancel();
+        REQUIRE(count == 1);
+        REQUIRE(!callback);
+    }
+    {
+        // Unregistering waits for a callback running on another thread.
+        cancellation_source source;
+        std::atomic<bool> started{};
+        std::atomic<bool> finished{};
+
+        auto callback = std::make_unique<cancellation_callback<std::function<void()>>>(source.token(), [&]
+        {
+            started = true;
+            std::this_thread::sleep_for(50ms);
+            finished = true;
+        });
+
+        std::thread canceling([&] { source.cancel(); });
+
+        while (!started)
+        {
+            std::this_thread::yield();
+        }
+
+        callback.reset();
+        REQUIRE(finished);
+        canceling.join();
+    }
+}
+
+#ifndef _WIN32
+TEST_CASE("coroutine,cancellation,deadline")
+{
+    {
+        cancellation_source source;
+        auto const start = steady_clock::now();
+        source.cancel_after(30ms);
+        std::promise<void> canceled;
+        cancellation_callback callback{ source.token(), [&] { canceled.set_value(); } };
+        canceled.get_future().get();
+        REQUIRE(steady_clock::now() - start >= 30ms);
+    }
+
+    auto wait = [](Foundation::TimeSpan duration, cancellation_token token, std::promise<bool>& result) -> fire_and_forget
+    {
+        result.set_value(co_await resume_after(duration, token));
+    };
+
+    {
+        // Elapsed without cancellation.
+        cancellation_source source;
+        std::promise<bool> result;
+        wait(20ms, source.token(), result);
+        REQUIRE(result.get_future().get());
+    }
+    {
+        std::promise<bool> result;
+        wait(20ms, {}, result);
+        REQUIRE(result.get_future().get());
+    }
+    {
+        // Canceled before the duration elapses.
+        cancellation_source source;
+        std::promise<bool> result;
+        auto const start = steady_clock::now();
+        wait(10s, source.token(), result);
+        source.cancel_after(20ms);
+        REQUIRE(!result.get_future().get());
+        REQUIRE(steady_clock::now() - start < 5s);
+    }
+    {
+        // Already canceled.
+        cancellation_source source;
+        source.cancel();
+        std::promise<bool> result;
+        wait(10s, source.token(), result);
+        REQUIRE(!result.get_future().get());
+    }
+}
+
+TEST_CASE("coroutine,cancellation,abandoned deadlines")
+{
+    auto& reactor = impl::reactor::instance();
+    size_t const timers = reactor.timer_count();
+
+    {
+        // Canceling the source removes its deadline.
+        cancellation_source source;
+        source.cancel_after(10s);
+        REQUIRE(reactor.timer_count() == timers + 1);
+        source.cancel();
+        REQUIRE(reactor.timer_count() == timers);
+    }
+    {
+        // So does dropping the source and its tokens, which also frees the state right away.
+        std::weak_ptr<impl::cancellation_state> state;
+        {
+            cancellation_source source;
+            state = impl::cancellation_access::state(source.token());
+            source.cancel_after(10s);
+        }
+        REQUIRE(state.expired());
+        REQUIRE(reactor.timer_count() == timers);
+    }
+    {
+        // A canceled wait removes its timer.
+        auto wait = [](cancellation_token token, std::promise<bool>& result) -> fire_and_forget
+        {
+            result.set_value(co_await resume_after(10s, token));
+        };
+
+        cancellation_source source;
+        std::promise<bool> result;
+        wait(source.token(), result);
+        REQUIRE(reactor.timer_count() == timers + 1);
+        source.cancel();
+        REQUIRE(!result.get_future().get());
+        REQUIRE(reactor.timer_count() == timers);
+    }
+}
+
+TEST_CASE("coroutine,cancellation,propagation")
+{
+    // Cancellation reaches every coroutine in a chain sharing the token, however deeply nested.
+    constexpr uint32_t coroutines = 1000;
+    cancellation_source source;
+    std::atomic<uint32_t> remaining{ coroutines };
+    std::atomic<uint32_t> elapsed{};
+    std::promise<void> done;
+
+    struct chain
+    {
+        static fire_and_forget run(uint32_t depth, cancellation_token token, std::atomic<uint32_t>& remaining, std::atomic<uint32_t>& elapsed, std::promise<void>& done)
+        {
+            if (depth != 0)
+            {
+                run(depth - 1, token, remaining, elapsed, done);
+            }
+
+            bool const completed = co_await resume_after(10s, token);
+
+            if (completed)
+            {
+                ++elapsed;
+            }
+
+            if (remaining.fetch_sub(1) == 1)
+            {
+                done.set_value();
+            }
+        }
+    };
+
+    for (uint32_t i = 0; i != coroutines / 10; ++i)
+    {
+        chain::run(9, source.token(), remaining, elapsed, done);
+    }
+
+    auto const start = steady_clock::now();
+    source.cancel();
+    done.get_future().get();
+    REQUIRE(elapsed == 0);
+    REQUIRE(steady_clock::now() - start < 5s);
+}
+#endif
+
+TEST_CASE("coroutine,benchmark,hops", "[.benchmark]")
+{
+    auto hop = [](uint32_t coroutines, uint32_t hops)
+    {
+        std::atomic<uint32_t> remaining{ coroutines };
+        std::promise<void> done;
+
+        for (uint32_t i = 0; i != coroutines; ++i)
+        {
+            hop_repeatedly(hops, remaining, done);
+        }
+
+        done.get_future().get();
+    };
+
+    BENCHMARK("1M hops on 1 coroutine")
+    {
+        hop(1, 1 << 20);
+    }
+
+    BENCHMARK("1M hops across 64 coroutines")
+    {
+        hop(64, 1 << 14);
+    }
+
+    BENCHMARK("1M hops across 4096 coroutines")
+    {
+        hop(4096, 1 << 8);
+    }
+}
+
+TEST_CASE("coroutine,benchmark,await", "[.benchmark]")
+{
+    BENCHMARK("1k concurrent awaits resumed inline")
+    {
+        await_many(1000, impl::inline_executor{});
+    }
+
+    BENCHMARK("100k concurrent awaits resumed inline")
+    {
+        await_many(100000, impl::inline_executor{});
+    }
+#ifndef _WIN32
+
+    BENCHMARK("1k concurrent awaits resumed on the thread pool")
+    {
+        await_many(1000, background_executor{});
+    }
+
+    BENCHMARK("100k concurrent awaits resumed on the thread pool")
+    {
+        await_many(100000, background_executor{});
+    }
+#endif
+}
+
+TEST_CASE("coroutine,benchmark,frames", "[.benchmark]")
+{
+    constexpr uint32_t coroutines = 100000;
+    uint32_t count{};
+    xlang_mem_enable_statistics(true);
+    xlang_mem_reset_statistics();
+
+    BENCHMARK("100k short-lived coroutines with frames from the PAL")
+    {
+        for (uint32_t i = 0; i != coroutines; ++i)
+        {
+            count_up<pal_task>(count);
+        }
+    }
+
+    uint64_t const pal = pal_allocations();
+    xlang_mem_reset_statistics();
+
+    BENCHMARK("100k short-lived coroutines with recycled frames")
+    {
+        for (uint32_t i = 0; i != coroutines; ++i)
+        {
+            count_up<recycled_task>(count);
+        }
+    }
+
+    uint64_t const recycled = pal_allocations();
+    xlang_mem_enable_statistics(false);
+
+    CAPTURE(pal, recycled);
+    REQUIRE(pal >= coroutines);
+    REQUIRE(recycled <= 1);
+}
@@ -0,0 +1,322 @@
+#include "pch.h"
+#include <thread>
+
+using namespace xlang;
+
+TEST_CASE("event,add,remove,invoke")
+{
+    event<delegate<int>> e;
+    REQUIRE(!e);
+
+    int total{};
+    auto const first = e.add([&](int value) { total += value; });
+    auto const second = e.add([&](int value) { total += value * 10; });
+    REQUIRE(e);
+    REQUIRE(first.value != second.value);
+
+    e(1);
+    REQUIRE(total == 11);
+
+    e.remove(first);
+    e(2);
+    REQUIRE(total == 31);
+
+    // Removing an unknown token leaves the targets alone.
+    e.remove(first);
+    e(3);
+    REQUIRE(total == 61);
+
+    e.remove(second);
+    REQUIRE(!e);
+    e(4);
+    REQUIRE(total == 61);
+}
+
+TEST_CASE("event,remove keeps order")
+{
+    event<delegate<>> e;
+    std::vector<int> calls;
+
+    delegate<> const repeated = [&] { calls.push_back(0); };
+    auto const repeated_token = e.add(repeated);
+    auto const middle = e.add([&] { calls.push_back(1); });
+    e.add([&] { calls.push_back(2); });
+    e.add(repeated);
+
+    e.remove(middle);
+    e();
+    REQUIRE(calls == std::vector<int>{ 0, 2, 0 });
+
+    // A delegate added twice is removed once per call, starting with the first occurrence.
+    calls.clear();
+    e.remove(repeated_token);
+    e();
+    REQUIRE(calls == std::vector<int>{ 2, 0 });
+}
+
+TEST_CASE("event,add_range,remove_range")
+{
+    event<delegate<int>> e;
+    int total{};
+
+    std::vector<delegate<int>> handlers;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        handlers.emplace_back([&total, i](int value) { total += value * i; });
+    }
+
+    std::vector<event_token> tokens = e.add_range(handlers);
+    REQUIRE(tokens.size() == 100);
+    REQUIRE(e.add_range({}).empty());
+
+    e(1);
+    REQUIRE(total == 4950);
+
+    // Remove the odd handlers, plus a token that is no longer registered.
+    std::vector<event_token> odd;
+
+    for (size_t i = 1; i < tokens.size(); i += 2)
+    {
+        odd.push_back(tokens[i]);
+    }
+
+    e.remove_range(odd);
+    e.remove_range(odd);
+    total = 0;
+    e(1);
+    REQUIRE(total == 2450);
+
+    // The same delegate added twice is removed once per token.
+    auto const first = e.add(handlers[2]);
+    auto const second = e.add(handlers[2]);
+    REQUIRE(first == second);
+    e.remove_range({ first });
+    total = 0;
+    e(1);
+    REQUIRE(total == 2452);
+
+    e.remove_range(tokens);
+    e.remove(second);
+    REQUIRE(!e);
+}
+
+TEST_CASE("event,remove during invoke")
+{
+    event<delegate<>> e;
+    int count{};
+    event_token token{};
+    token = e.add([&] { ++count; e.remove(token); });
+
+    e();
+    e();
+    REQUIRE(count == 1);
+    REQUIRE(!e);
+}
+
+TEST_CASE("event,concurrent invoke and change")
+{
+    event<delegate<>> e;
+    std::atomic<uint32_t> count{};
+    e.add([&] { ++count; });
+
+    std::atomic<bool> done{};
+    std::vector<std::thread> raisers;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        raisers.emplace_back([&]
+        {
+            while (!done)
+            {
+                e();
+            }
+        });
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        e.remove(e.add([] {}));
+    }
+
+    done = true;
+
+    for (auto& raiser : raisers)
+    {
+        raiser.join();
+    }
+
+    uint32_t const before = count;
+    e();
+    REQUIRE(count == before + 1);
+}
+
+TEST_CASE("event,delegate lifetime")
+{
+    auto counter = std::make_shared<int>();
+
+    {
+        // Freed delegates are recycled by the next one of a similar size.
+        delegate<> first([counter] { ++*counter; });
+        void* const abi = get_abi(first);
+        first = nullptr;
+
+        delegate<> second([counter] { ++*counter; });
+        REQUIRE(get_abi(second) == abi);
+    }
+
+    REQUIRE(counter.use_count() == 1);
+
+    {
+        // A delegate shared with another thread is released by whichever thread drops the last reference.
+        event<delegate<>> e;
+        auto const token = e.add([counter] { ++*counter; });
+
+        std::thread([&, copy = delegate<>([counter] { ++*counter; })]
+        {
+            e();
+            copy();
+            e.remove(token);
+        }).join();
+
+        REQUIRE(*counter == 2);
+    }
+
+    REQUIRE(counter.use_count() == 1);
+
+    {
+        // Several threads may copy the same delegate object at once.
+        delegate<> const shared([counter] { ++*counter; });
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i != 4; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                for (uint32_t j = 0; j != 10000; ++j)
+                {
+                    delegate<> copy = shared;
+                }
+            });
+        }
+
+        for (auto&& thread : threads)
+        {
+            thread.join();
+        }
+
+        shared();
+        REQUIRE(*counter == 3);
+    }
+
+    REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("event,benchmark,subscription churn", "[.benchmark]")
+{
+    event<delegate<int>> e;
+    int total{};
+    e.add([&](int value) { total += value; });
+
+    constexpr uint32_t iterations = 100000;
+
+    BENCHMARK("add and remove a handler 100k times")
+    {
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            e.remove(e.add([&total](int value) { total -= value; }));
+        }
+    }
+
+    BENCHMARK("add, raise and remove a handler 100k times")
+    {
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            auto const token = e.add([&total](int value) { total -= value; });
+            e(1);
+            e.remove(token);
+        }
+    }
+
+    REQUIRE(total == 0);
+}
+
+TEST_CASE("event,benchmark,contention", "[.benchmark]")
+{
+    event<delegate<>> e;
+    std::atomic<uint64_t> count{};
+    e.add([&] { count.fetch_add(1, std::memory_order_relaxed); });
+
+    constexpr uint32_t raises = 640000;
+
+    auto raise_on_threads = [&](uint32_t const thread_count)
+    {
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i != thread_count; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                for (uint32_t j = 0; j != raises / thread_count; ++j)
+                {
+                    e();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    };
+
+    BENCHMARK("raise on 1 thread")
+    {
+        raise_on_threads(1);
+    }
+
+    BENCHMARK("raise on 8 threads")
+    {
+        raise_on_threads(8);
+    }
+
+    BENCHMARK("raise on 64 threads")
+    {
+        raise_on_threads(64);
+    }
+
+    REQUIRE(count == raises * 3);
+}
+
+TEST_CASE("event,benchmark,attach", "[.benchmark]")
+{
+    constexpr uint32_t count = 10000;
+    std::vector<delegate<>> handlers;
+
+    for (uint32_t i = 0; i != count; ++i)
+    {
+        handlers.emplace_back([] {});
+    }
+
+    BENCHMARK("add 10k handlers one at a time")
+    {
+        event<delegate<>> e;
+
+        for (auto const& handler : handlers)
+        {
+            e.add(handler);
+        }
+    }
+
+    BENCHMARK("add 10k handlers as a range")
+    {
+        event<delegate<>> e;
+        e.add_range(handlers);
+    }
+
+    BENCHMARK("add and remove 10k handlers as ranges")
+    {
+        event<delegate<>> e;
+        e.remove_range(e.add_range(handlers));
+    }
+}
\ No newline at end of file
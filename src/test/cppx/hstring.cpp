@@ -1,4 +1,5 @@
 #include "pch.h"
+#include <set>
 
 using namespace xlang;
 
@@ -576,8 +577,210 @@ TEST_CASE("hstring,unordered_map")
     REQUIRE(m[u8"def"] == 20);
 }
 
+TEST_CASE("hstring,hash")
+{
+    std::hash<hstring> const hash;
+    REQUIRE(hash(hstring(u8"abc")) == hash(hstring(u8string(u8"abc"))));
+    REQUIRE(hash(hstring()) == hash(hstring(u8"")));
+
+    // Strings differing only in their length, or in a single byte of the tail or of a full word.
+    u8string const text(u8"The quick brown fox jumps over the lazy dog");
+    std::set<size_t> hashes;
+
+    for (size_t length = 0; length <= text.size(); ++length)
+    {
+        u8string value = text.substr(0, length);
+        REQUIRE(hashes.insert(hash(hstring(value))).second);
+
+        for (auto& c : value)
+        {
+            ++c;
+            REQUIRE(hashes.insert(hash(hstring(value))).second);
+            --c;
+        }
+    }
+}
+
+TEST_CASE("hstring,benchmark,hash", "[.benchmark]")
+{
+    std::vector<hstring> values;
+
+    for (uint32_t i = 0; i != 1000; ++i)
+    {
+        u8string value(u8"Windows.Foundation.Collections.IVector`1<Object#");
+        value += u8string_view(to_hstring(i));
+        values.push_back(hstring(value));
+    }
+
+    BENCHMARK("std::hash<hstring> of 1000 strings")
+    {
+        size_t result = 0;
+
+        for (hstring const& value : values)
+        {
+            result += std::hash<hstring>{}(value);
+        }
+
+        REQUIRE(result != 0);
+    }
+
+    std::unordered_map<hstring, uint32_t> map;
+
+    for (uint32_t i = 0; i != values.size(); ++i)
+    {
+        map[values[i]] = i;
+    }
+
+    BENCHMARK("std::unordered_map<hstring> lookup of 1000 strings")
+    {
+        for (uint32_t i = 0; i != values.size(); ++i)
+        {
+            REQUIRE(map.find(values[i])->second == i);
+        }
+    }
+}
+
+TEST_CASE("hstring,benchmark,create_copy_destroy", "[.benchmark]")
+{
+    constexpr uint32_t iterations = 100000;
+    u8string const long_value(200, u8'x');
+
+    BENCHMARK("short hstring created, copied and destroyed")
+    {
+        size_t size = 0;
+
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            hstring const value{ u8"PropertyName" };
+            hstring const copy = value;
+            size += copy.size();
+        }
+
+        REQUIRE(size == 12 * iterations);
+    }
+
+    BENCHMARK("long hstring created, copied and destroyed")
+    {
+        size_t size = 0;
+
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            hstring const value{ long_value };
+            hstring const copy = value;
+            size += copy.size();
+        }
+
+        REQUIRE(size == 200 * iterations);
+    }
+}
+
 static bool compare_hash(const u8string & value)
 {
     return std::hash<u8string>{}(value) == std::hash<hstring>{}(hstring(value));
 }
 
+
+TEST_CASE("hstring,benchmark,store_param", "[.benchmark]")
+{
+    // Mirrors a produce shim receiving a fast-pass string parameter and a component
+    // implementation storing it in more than one place.
+    struct component
+    {
+        void Name(hstring const& value)
+        {
+            m_name = value;
+            m_display_name = value;
+            m_sort_key = value;
+        }
+
+        hstring m_name;
+        hstring m_display_name;
+        hstring m_sort_key;
+    };
+
+    component c;
+    constexpr uint32_t iterations = 100000;
+
+    BENCHMARK("param::hstring stored three times")
+    {
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            param::hstring const value{ u8"A component name" };
+            c.Name(value);
+        }
+    }
+
+    BENCHMARK("hstring stored three times")
+    {
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            hstring const value{ u8"A component name" };
+            c.Name(value);
+        }
+    }
+
+    REQUIRE(c.m_name == u8"A component name");
+    REQUIRE(get_abi(c.m_name) == get_abi(c.m_sort_key));
+}
+
+TEST_CASE("static_hstring")
+{
+    static constexpr static_hstring empty{ u8"" };
+    static constexpr static_hstring name{ u8"Name" };
+    static constexpr static_hstring wide{ u8"é中\U0001f600" };
+    static_assert(name.view() == u8"Name");
+
+    REQUIRE(hstring(empty).empty());
+    REQUIRE(get_abi(empty) == nullptr);
+
+    hstring const copy = name;
+    REQUIRE(copy == u8"Name");
+    REQUIRE(get_abi(copy) == get_abi(name));
+
+    hstring assigned;
+    assigned = copy;
+    REQUIRE(get_abi(assigned) == get_abi(copy));
+
+    param::hstring const param = name;
+    REQUIRE(get_abi(param) == get_abi(copy));
+
+    char16_t const* buffer{};
+    uint32_t length{};
+    REQUIRE(xlang_get_string_raw_buffer_utf16(get_abi(wide), &buffer, &length) == nullptr);
+    REQUIRE(std::u16string_view(buffer, length) == u"é中\U0001f600");
+    REQUIRE(hstring(wide) == hstring(u"é中\U0001f600"));
+}
+
+TEST_CASE("hstring,benchmark,static_hstring", "[.benchmark]")
+{
+    static constexpr static_hstring name{ u8"PropertyName" };
+    constexpr uint32_t iterations = 100000;
+
+    BENCHMARK("static_hstring copied and destroyed")
+    {
+        size_t size = 0;
+
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            hstring const copy = name;
+            size += copy.size();
+        }
+
+        REQUIRE(size == 12 * iterations);
+    }
+
+    hstring const value{ u8"PropertyName" };
+
+    BENCHMARK("hstring copied and destroyed")
+    {
+        size_t size = 0;
+
+        for (uint32_t i = 0; i != iterations; ++i)
+        {
+            hstring const copy = value;
+            size += copy.size();
+        }
+
+        REQUIRE(size == 12 * iterations);
+    }
+}
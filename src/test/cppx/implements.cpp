@@ -0,0 +1,606 @@
+#include "pch.h"
+#include <thread>
+
+using namespace xlang;
+
+namespace
+{
+    template <uint32_t Index>
+    struct ITest : Windows::Foundation::IXlangObject
+    {
+        ITest(std::nullptr_t = nullptr) noexcept {}
+        ITest(void* ptr, take_ownership_from_abi_t) noexcept : IXlangObject(ptr, take_ownership_from_abi) {}
+    };
+
+    // Interfaces from 100 on share the first word of their guids.
+    constexpr uint32_t test_guid_key(uint32_t const index) noexcept
+    {
+        return index < 100 ? index * 0x9E3779B9u : 0xFFFFFFFFu;
+    }
+}
+
+namespace xlang::impl
+{
+    template <uint32_t Index> struct abi<ITest<Index>>
+    {
+        struct XLANG_NOVTABLE type : xlang_object_abi
+        {
+        };
+    };
+
+    template <uint32_t Index> struct guid_storage<ITest<Index>>
+    {
+        static constexpr guid value{ test_guid_key(Index), 0x5f3a, 0x4c21, { 0x9b, 0x1e, 0x27, 0x44, 0xd0, 0x6c, 0x83, static_cast<uint8_t>(Index) } };
+    };
+
+    template <typename D, uint32_t Index> struct produce<D, ITest<Index>> : produce_base<D, ITest<Index>>
+    {
+    };
+}
+
+namespace
+{
+    template <uint32_t... Index>
+    struct test_object : implements<test_object<Index...>, ITest<Index>...>
+    {
+    };
+
+    template <uint32_t Offset, size_t... Index>
+    auto make_test_object(std::index_sequence<Index...>)
+    {
+        return make<test_object<static_cast<uint32_t>(Offset + Index)...>>();
+    }
+
+    template <uint32_t Count, uint32_t Offset = 0>
+    auto make_test_object()
+    {
+        return make_test_object<Offset>(std::make_index_sequence<Count>());
+    }
+
+    template <uint32_t Index>
+    void* query(Windows::Foundation::IXlangObject const& object)
+    {
+        void* result{};
+
+        if (static_cast<impl::unknown_abi*>(get_abi(object))->QueryInterface(guid_of<ITest<Index>>(), &result) != impl::error_ok)
+        {
+            return nullptr;
+        }
+
+        static_cast<impl::unknown_abi*>(result)->Release();
+        return result;
+    }
+
+    // Every interface is found at the address of its own vtable.
+    template <uint32_t... Index>
+    void require_interfaces(std::integer_sequence<uint32_t, Index...>)
+    {
+        auto object = make<test_object<Index...>>();
+        auto self = get_self<test_object<Index...>>(object);
+        REQUIRE(((query<Index>(object) == to_abi<ITest<Index>>(self)) && ...));
+    }
+}
+
+TEST_CASE("implements,QueryInterface")
+{
+    {
+        auto object = make_test_object<1>();
+        REQUIRE(query<0>(object) == get_abi(object));
+        REQUIRE(query<1>(object) == nullptr);
+        REQUIRE(object.as<Windows::Foundation::IUnknown>());
+    }
+    {
+        require_interfaces(std::make_integer_sequence<uint32_t, 32>());
+
+        auto object = make_test_object<32>();
+        REQUIRE(query<32>(object) == nullptr);
+        REQUIRE(query<100>(object) == nullptr);
+    }
+    {
+        // Interfaces sharing the first word of their guids are told apart by the rest of it.
+        auto object = make_test_object<4, 100>();
+        REQUIRE(query<100>(object) != nullptr);
+        REQUIRE(query<103>(object) != nullptr);
+        REQUIRE(query<100>(object) != query<103>(object));
+        REQUIRE(query<104>(object) == nullptr);
+        REQUIRE(query<0>(object) == nullptr);
+    }
+}
+
+namespace
+{
+    template <uint32_t Count>
+    uint32_t query_all(Windows::Foundation::IXlangObject const& object)
+    {
+        uint32_t found{};
+
+        for (uint32_t iteration = 0; iteration != 10'000; ++iteration)
+        {
+            found += query<Count - 1>(object) != nullptr;
+            found += query<Count / 2>(object) != nullptr;
+            found += query<0>(object) != nullptr;
+        }
+
+        return found;
+    }
+}
+
+TEST_CASE("implements,benchmark,QueryInterface", "[.benchmark]")
+{
+    auto one = make_test_object<1>();
+    auto four = make_test_object<4>();
+    auto sixteen = make_test_object<16>();
+    auto sixty_four = make_test_object<64>();
+
+    BENCHMARK("30k queries of 1 interface")
+    {
+        REQUIRE(query_all<1>(one) == 30'000);
+    }
+
+    BENCHMARK("30k queries of 4 interfaces")
+    {
+        REQUIRE(query_all<4>(four) == 30'000);
+    }
+
+    BENCHMARK("30k queries of 16 interfaces")
+    {
+        REQUIRE(query_all<16>(sixteen) == 30'000);
+    }
+
+    BENCHMARK("30k queries of 64 interfaces")
+    {
+        REQUIRE(query_all<64>(sixty_four) == 30'000);
+    }
+}
+
+TEST_CASE("implements,weak_ref")
+{
+    using object_type = test_object<0>;
+    auto object = make_self<object_type>();
+
+    weak_ref<object_type> const self_weak = object;
+    weak_ref<ITest<0>> const interface_weak = object.as<ITest<0>>();
+
+    // A weak reference filled in through put() can't be assumed to be the object's own.
+    weak_ref<object_type> put_weak;
+    object.as<impl::IWeakReferenceSource>()->GetWeakReference(put_weak.put());
+
+    REQUIRE(self_weak.get().get() == object.get());
+    REQUIRE(put_weak.get().get() == object.get());
+    REQUIRE(get_self<object_type>(interface_weak.get()) == object.get());
+
+    {
+        // Resolving adds exactly one reference.
+        auto const strong = self_weak.get();
+        REQUIRE(object->AddRef() == 3);
+        object->Release();
+    }
+
+    REQUIRE(object->AddRef() == 2);
+    object->Release();
+
+    object = nullptr;
+    REQUIRE(!self_weak.get());
+    REQUIRE(!put_weak.get());
+    REQUIRE(!interface_weak.get());
+}
+
+TEST_CASE("implements,benchmark,weak_ref", "[.benchmark]")
+{
+    using object_type = test_object<0>;
+    auto object = make_self<object_type>();
+    weak_ref<object_type> const self_weak = object;
+    weak_ref<ITest<0>> const interface_weak = object.as<ITest<0>>();
+
+    constexpr uint32_t upgrades = 800'000;
+
+    auto upgrade_on_threads = [](uint32_t const thread_count, auto const& weak)
+    {
+        std::atomic<uint32_t> resolved{};
+        std::vector<std::thread> threads;
+
+        for (uint32_t i = 0; i != thread_count; ++i)
+        {
+            threads.emplace_back([&]
+            {
+                uint32_t count{};
+
+                for (uint32_t j = 0; j != upgrades / thread_count; ++j)
+                {
+                    count += static_cast<bool>(weak.get());
+                }
+
+                resolved += count;
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        return resolved.load();
+    };
+
+    BENCHMARK("implementation upgraded on 1 thread")
+    {
+        REQUIRE(upgrade_on_threads(1, self_weak) == upgrades);
+    }
+
+    BENCHMARK("implementation upgraded on 8 threads")
+    {
+        REQUIRE(upgrade_on_threads(8, self_weak) == upgrades);
+    }
+
+    BENCHMARK("interface upgraded on 1 thread")
+    {
+        REQUIRE(upgrade_on_threads(1, interface_weak) == upgrades);
+    }
+
+    BENCHMARK("interface upgraded on 8 threads")
+    {
+        REQUIRE(upgrade_on_threads(8, interface_weak) == upgrades);
+    }
+}
+
+namespace test_component
+{
+    struct IWidget;
+}
+
+// A hand-written projection of an interface with bulk properties, which tests the support in base.h on platforms
+// that can't generate projections from metadata. The generated projection is tested by bulk_properties.cpp.
+namespace xlang::impl
+{
+    template <> struct abi<test_component::IWidget>
+    {
+        struct XLANG_NOVTABLE type : xlang_object_abi
+        {
+            virtual int32_t XLANG_CALL get_Name(xlang_string* value) noexcept = 0;
+            virtual int32_t XLANG_CALL get_Width(int32_t* value) noexcept = 0;
+            virtual int32_t XLANG_CALL get_Height(int32_t* value) noexcept = 0;
+            virtual int32_t XLANG_CALL get_Enabled(bool* value) noexcept = 0;
+            virtual int32_t XLANG_CALL get_Scale(double* value) noexcept = 0;
+        };
+    };
+
+    template <> struct guid_storage<test_component::IWidget>
+    {
+        static constexpr guid value{ 0x3c1d8e52, 0x7a40, 0x4b9f, { 0x8e, 0x21, 0x5d, 0x6a, 0x90, 0x13, 0xc4, 0x7b } };
+    };
+
+    template <typename D>
+    struct consume_test_component_IWidget
+    {
+        hstring Name() const;
+        int32_t Width() const;
+        int32_t Height() const;
+        bool Enabled() const;
+        double Scale() const;
+        bulk_properties<test_component::IWidget> GetBulkProperties() const;
+    };
+    template <> struct consume<test_component::IWidget>
+    {
+        template <typename D> using type = consume_test_component_IWidget<D>;
+    };
+
+    struct struct_bulk_properties_test_component_IWidget
+    {
+        xlang_string Name;
+        int32_t Width;
+        int32_t Height;
+        bool Enabled;
+        double Scale;
+    };
+    template <> struct abi<bulk_properties<test_component::IWidget>>
+    {
+        using type = struct_bulk_properties_test_component_IWidget;
+    };
+    template <> struct bulk_properties_abi<test_component::IWidget>
+    {
+        struct XLANG_NOVTABLE type : unknown_abi
+        {
+            virtual int32_t XLANG_CALL GetBulkProperties(struct_bulk_properties_test_component_IWidget* value) noexcept = 0;
+        };
+    };
+}
+
+namespace test_component
+{
+    struct IWidget : Windows::Foundation::IXlangObject, impl::consume_t<IWidget>
+    {
+        IWidget(std::nullptr_t = nullptr) noexcept {}
+        IWidget(void* ptr, take_ownership_from_abi_t) noexcept : IXlangObject(ptr, take_ownership_from_abi) {}
+    };
+}
+
+namespace xlang
+{
+    template <> struct bulk_properties<test_component::IWidget>
+    {
+        hstring Name;
+        int32_t Width;
+        int32_t Height;
+        bool Enabled;
+        double Scale;
+    };
+}
+
+namespace xlang::impl
+{
+    template <typename D> hstring consume_test_component_IWidget<D>::Name() const
+    {
+        hstring value;
+        check_hresult(XLANG_SHIM(test_component::IWidget)->get_Name(put_abi(value)));
+        return value;
+    }
+    template <typename D> int32_t consume_test_component_IWidget<D>::Width() const
+    {
+        int32_t value;
+        check_hresult(XLANG_SHIM(test_component::IWidget)->get_Width(&value));
+        return value;
+    }
+    template <typename D> int32_t consume_test_component_IWidget<D>::Height() const
+    {
+        int32_t value;
+        check_hresult(XLANG_SHIM(test_component::IWidget)->get_Height(&value));
+        return value;
+    }
+    template <typename D> bool consume_test_component_IWidget<D>::Enabled() const
+    {
+        bool value;
+        check_hresult(XLANG_SHIM(test_component::IWidget)->get_Enabled(&value));
+        return value;
+    }
+    template <typename D> double consume_test_component_IWidget<D>::Scale() const
+    {
+        double value;
+        check_hresult(XLANG_SHIM(test_component::IWidget)->get_Scale(&value));
+        return value;
+    }
+    template <typename D> bulk_properties<test_component::IWidget> consume_test_component_IWidget<D>::GetBulkProperties() const
+    {
+        bulk_properties<test_component::IWidget> value;
+        if (!try_get_bulk_properties(XLANG_SHIM(test_component::IWidget), value))
+        {
+            value.Name = this->Name();
+            value.Width = this->Width();
+            value.Height = this->Height();
+            value.Enabled = this->Enabled();
+            value.Scale = this->Scale();
+        }
+        return value;
+    }
+
+    template <typename D> struct produce<D, test_component::IWidget> : produce_bulk_properties_base<D, test_component::IWidget>
+    {
+        int32_t XLANG_CALL get_Name(xlang_string* value) noexcept final try
+        {
+            clear_abi(value);
+            typename D::abi_guard guard(this->shim());
+            *value = detach_from<hstring>(this->shim().Name());
+            return 0;
+        }
+        catch (...) { return to_hresult(); }
+        int32_t XLANG_CALL get_Width(int32_t* value) noexcept final try
+        {
+            typename D::abi_guard guard(this->shim());
+            *value = detach_from<int32_t>(this->shim().Width());
+            return 0;
+        }
+        catch (...) { return to_hresult(); }
+        int32_t XLANG_CALL get_Height(int32_t* value) noexcept final try
+        {
+            typename D::abi_guard guard(this->shim());
+            *value = detach_from<int32_t>(this->shim().Height());
+            return 0;
+        }
+        catch (...) { return to_hresult(); }
+        int32_t XLANG_CALL get_Enabled(bool* value) noexcept final try
+        {
+            typename D::abi_guard guard(this->shim());
+            *value = detach_from<bool>(this->shim().Enabled());
+            return 0;
+        }
+        catch (...) { return to_hresult(); }
+        int32_t XLANG_CALL get_Scale(double* value) noexcept final try
+        {
+            typename D::abi_guard guard(this->shim());
+            *value = detach_from<double>(this->shim().Scale());
+            return 0;
+        }
+        catch (...) { return to_hresult(); }
+        int32_t XLANG_CALL GetBulkProperties(struct_bulk_properties_test_component_IWidget* value) noexcept final try
+        {
+            typename D::abi_guard guard(this->shim());
+            ::new (value) bulk_properties<test_component::IWidget>{
+                this->shim().Name(),
+                this->shim().Width(),
+                this->shim().Height(),
+                this->shim().Enabled(),
+                this->shim().Scale(),
+            };
+            return 0;
+        }
+        catch (...)
+        {
+            zero_abi<bulk_properties<test_component::IWidget>>(value);
+            return to_hresult();
+        }
+    };
+}
+
+namespace
+{
+    struct widget : implements<widget, test_component::IWidget>
+    {
+        explicit widget(bool const closed = false) noexcept : m_closed(closed)
+        {
+        }
+
+        hstring Name() const { return m_name; }
+        int32_t Width() const noexcept { return 640; }
+        int32_t Height() const noexcept { return 480; }
+        bool Enabled() const noexcept { return true; }
+
+        double Scale() const
+        {
+            if (m_closed)
+            {
+                throw hresult_illegal_method_call();
+            }
+
+            return 1.5;
+        }
+
+    private:
+
+        hstring const m_name{ u8"widget" };
+        bool const m_closed;
+    };
+
+    // An implementation from another projection, which only has the interface described by the metadata.
+    struct legacy_widget final : impl::abi_t<test_component::IWidget>
+    {
+        int32_t XLANG_CALL QueryInterface(guid const& id, void** object) noexcept final
+        {
+            if (is_guid_of<test_component::IWidget>(id) || is_guid_of<Windows::Foundation::IXlangObject>(id) || is_guid_of<Windows::Foundation::IUnknown>(id))
+            {
+                *object = this;
+                AddRef();
+                return 0;
+            }
+
+            *object = nullptr;
+            return impl::error_no_interface;
+        }
+
+        uint32_t XLANG_CALL AddRef() noexcept final
+        {
+            return ++m_references;
+        }
+
+        uint32_t XLANG_CALL Release() noexcept final
+        {
+            uint32_t const target = --m_references;
+
+            if (target == 0)
+            {
+                delete this;
+            }
+
+            return target;
+        }
+
+        bool GetObjectInfo(XlangObjectInfoCategory, void**) noexcept final
+        {
+            return false;
+        }
+
+        bool Equals(impl::xlang_object_abi* object) noexcept final
+        {
+            return object == this;
+        }
+
+        int32_t XLANG_CALL get_Name(xlang_string* value) noexcept final
+        {
+            *value = detach_abi(hstring{ u8"legacy" });
+            return 0;
+        }
+
+        int32_t XLANG_CALL get_Width(int32_t* value) noexcept final
+        {
+            *value = 320;
+            return 0;
+        }
+
+        int32_t XLANG_CALL get_Height(int32_t* value) noexcept final
+        {
+            *value = 240;
+            return 0;
+        }
+
+        int32_t XLANG_CALL get_Enabled(bool* value) noexcept final
+        {
+            *value = false;
+            return 0;
+        }
+
+        int32_t XLANG_CALL get_Scale(double* value) noexcept final
+        {
+            *value = 2.0;
+            return 0;
+        }
+
+    private:
+
+        std::atomic<uint32_t> m_references{ 1 };
+    };
+}
+
+TEST_CASE("implements,bulk properties")
+{
+    test_component::IWidget const object = make<widget>();
+
+    auto const properties = object.GetBulkProperties();
+    REQUIRE(properties.Name == object.Name());
+    REQUIRE(properties.Width == object.Width());
+    REQUIRE(properties.Height == object.Height());
+    REQUIRE(properties.Enabled == object.Enabled());
+    REQUIRE(properties.Scale == object.Scale());
+
+    // The bulk properties interface has its own guid and shares the object's identity.
+    com_ptr<impl::bulk_properties_abi_t<test_component::IWidget>> bulk;
+    REQUIRE(static_cast<impl::unknown_abi*>(get_abi(object))->QueryInterface(impl::bulk_properties_guid<test_component::IWidget>::value, bulk.put_void()) == 0);
+    REQUIRE(!is_guid_of<test_component::IWidget>(impl::bulk_properties_guid<test_component::IWidget>::value));
+    REQUIRE(get_abi(bulk.as<test_component::IWidget>()) == get_abi(object));
+
+    // The name has already been read when reading the scale fails, and must not be returned.
+    test_component::IWidget const closed = make<widget>(true);
+    REQUIRE_THROWS_AS(closed.GetBulkProperties(), hresult_illegal_method_call);
+    REQUIRE(closed.Name() == u8"widget");
+}
+
+TEST_CASE("implements,bulk properties,fallback")
+{
+    // Objects without the bulk properties interface are read a property at a time.
+    test_component::IWidget const object{ static_cast<impl::xlang_object_abi*>(new legacy_widget), take_ownership_from_abi };
+
+    auto const properties = object.GetBulkProperties();
+    REQUIRE(properties.Name == u8"legacy");
+    REQUIRE(properties.Width == 320);
+    REQUIRE(properties.Height == 240);
+    REQUIRE(!properties.Enabled);
+    REQUIRE(properties.Scale == 2.0);
+}
+
+TEST_CASE("implements,benchmark,bulk properties", "[.benchmark]")
+{
+    test_component::IWidget const object = make<widget>();
+    constexpr uint32_t reads = 100'000;
+
+    BENCHMARK("100k objects read a property at a time")
+    {
+        uint64_t total{};
+
+        for (uint32_t i = 0; i != reads; ++i)
+        {
+            total += object.Name().size() + object.Width() + object.Height() + object.Enabled() + static_cast<uint32_t>(object.Scale());
+        }
+
+        REQUIRE(total == reads * uint64_t{ 6 + 640 + 480 + 1 + 1 });
+    }
+
+    BENCHMARK("100k objects read in bulk")
+    {
+        uint64_t total{};
+
+        for (uint32_t i = 0; i != reads; ++i)
+        {
+            auto const properties = object.GetBulkProperties();
+            total += properties.Name.size() + properties.Width + properties.Height + properties.Enabled + static_cast<uint32_t>(properties.Scale);
+        }
+
+        REQUIRE(total == reads * uint64_t{ 6 + 640 + 480 + 1 + 1 });
+    }
+}
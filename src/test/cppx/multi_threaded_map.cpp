@@ -0,0 +1,205 @@
+#include "pch.h"
+#include <xlang/Foundation.Collections.h>
+#include "catch.hpp"
+#include <thread>
+
+using namespace xlang;
+using namespace Foundation::Collections;
+
+namespace
+{
+    void compare(IMap<int, int> const & left, std::map<int, int> && right)
+    {
+        std::map<int, int> copy;
+
+        for (auto pair : left)
+        {
+            copy[pair.Key()] = pair.Value();
+        }
+
+        REQUIRE(copy == right);
+    }
+
+    template <typename Change>
+    void test_snapshot(IMap<int, int> const & values, Change change)
+    {
+        std::array<IKeyValuePair<int, int>, 3> array;
+
+        values.Clear();
+        values.Insert(1,10);
+        values.Insert(2,20);
+        values.Insert(3,30);
+        IIterator<IKeyValuePair<int, int>> first = values.First();
+        REQUIRE(first.Current().Key() == 1);
+
+        change(); // <-- doesn't invalidate
+
+        REQUIRE(first.HasCurrent());
+        REQUIRE(first.Current().Value() == 10);
+        REQUIRE(first.MoveNext());
+        REQUIRE(first.GetMany(array) == 2);
+        REQUIRE(array[0].Key() == 2);
+        REQUIRE(array[1].Value() == 30);
+        REQUIRE(!first.HasCurrent());
+    }
+
+    // Runs the readers until the writer is done. Catch assertions may only be made on the test's own thread, so
+    // readers instead return false on failure and the number of failed reads is returned.
+    template <typename Read, typename Write>
+    uint32_t run_contended(uint32_t const readers, Read read, Write write)
+    {
+        std::atomic<bool> done{};
+        std::atomic<uint32_t> failures{};
+        std::vector<std::thread> threads;
+
+        for (uint32_t index = 0; index < readers; ++index)
+        {
+            threads.emplace_back([&]
+            {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    if (!read())
+                    {
+                        ++failures;
+                    }
+                }
+            });
+        }
+
+        write();
+        done = true;
+
+        for (auto&& thread : threads)
+        {
+            thread.join();
+        }
+
+        return failures;
+    }
+}
+
+TEST_CASE("multi_threaded_map - construction")
+{
+    IMap<int, int> values;
+
+    values = multi_threaded_map<int, int>();
+    REQUIRE(values.Size() == 0);
+
+    values = multi_threaded_map<int, int>(std::map<int, int>{ { 1,10 },{ 2,20 },{ 3,30 } });
+    compare(values, { { 1,10 },{ 2,20 },{ 3,30 } });
+
+    values = multi_threaded_map<int, int>(std::unordered_map<int, int>{ { 1, 10 }, { 2,20 }, { 3,30 } });
+    compare(values, { { 1,10 },{ 2,20 },{ 3,30 } });
+}
+
+TEST_CASE("test_multi_threaded_map")
+{
+    IMap<int, int> values = multi_threaded_map<int, int>();
+
+    REQUIRE(!values.Insert(1, 10));
+    REQUIRE(values.Insert(1, 100));
+    REQUIRE(!values.Insert(2, 20));
+    compare(values, { { 1,100 },{ 2,20 } });
+
+    REQUIRE(values.HasKey(2));
+    REQUIRE(values.Lookup(2) == 20);
+    REQUIRE_THROWS_AS(values.Lookup(3), hresult_out_of_bounds);
+
+    values.Remove(2);
+    compare(values, { { 1,100 } });
+    values.Clear();
+    compare(values, {});
+
+    test_snapshot(values, [&] { values.Clear(); });
+    test_snapshot(values, [&] { values.Remove(1); });
+    test_snapshot(values, [&] { values.Insert(1,100); });
+}
+
+TEST_CASE("multi_threaded_map - concurrency")
+{
+    std::map<int, int> initial;
+
+    for (int key = 0; key < 100; ++key)
+    {
+        initial[key] = key * 10;
+    }
+
+    IMap<int, int> values = multi_threaded_map<int, int>(std::move(initial));
+
+    // The writer repeatedly adds and removes one extra key, so readers must always see the original keys with
+    // their original values and either 100 or 101 elements in total.
+    uint32_t const failures = run_contended(4, [&]
+    {
+        uint32_t count{};
+
+        for (auto&& pair : values)
+        {
+            if (pair.Value() != pair.Key() * 10)
+            {
+                return false;
+            }
+
+            ++count;
+        }
+
+        uint32_t const size = values.Size();
+
+        return (count == 100 || count == 101) &&
+            (size == 100 || size == 101) &&
+            values.HasKey(50) &&
+            values.Lookup(99) == 990;
+    },
+    [&]
+    {
+        for (int version = 0; version < 1000; ++version)
+        {
+            values.Insert(100, 1000);
+            values.Remove(100);
+        }
+    });
+
+    REQUIRE(failures == 0);
+    REQUIRE(values.Size() == 100);
+}
+
+TEST_CASE("multi_threaded_map - contention benchmark", "[.benchmark]")
+{
+    uint32_t const readers = (std::max)(2u, std::thread::hardware_concurrency()) - 1;
+    std::unordered_map<int, int> initial;
+
+    for (int key = 0; key < 1000; ++key)
+    {
+        initial[key] = key;
+    }
+
+    IMap<int, int> values = multi_threaded_map<int, int>(std::move(initial));
+
+    BENCHMARK("read-heavy: Lookup with one writer")
+    {
+        std::atomic<bool> done{};
+        std::vector<std::thread> threads;
+
+        for (uint32_t index = 0; index < readers; ++index)
+        {
+            threads.emplace_back([&]
+            {
+                for (int key = 0; !done.load(std::memory_order_relaxed); key = (key + 1) % 1000)
+                {
+                    values.Lookup(key);
+                }
+            });
+        }
+
+        for (int key = 0; key < 10'000; ++key)
+        {
+            values.Insert(key % 1000, key % 1000);
+        }
+
+        done = true;
+
+        for (auto&& thread : threads)
+        {
+            thread.join();
+        }
+    }
+}
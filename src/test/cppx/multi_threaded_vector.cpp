@@ -0,0 +1,181 @@
+#include "pch.h"
+#include <xlang/Foundation.Collections.h>
+#include "catch.hpp"
+#include <numeric>
+#include <thread>
+
+using namespace xlang;
+using namespace Foundation::Collections;
+
+namespace
+{
+    void compare(IVector<int> const & left, std::vector<int> && right)
+    {
+        std::vector<int> copy(begin(left), end(left));
+        REQUIRE(copy == right);
+    }
+
+    template <typename Change>
+    void test_snapshot(IVector<int> const & values, Change change)
+    {
+        std::array<int, 3> array;
+
+        values.ReplaceAll({ 1,2,3 });
+        IIterator<int> first = values.First();
+        REQUIRE(first.Current() == 1);
+
+        change(); // <-- doesn't invalidate
+
+        REQUIRE(first.HasCurrent());
+        REQUIRE(first.Current() == 1);
+        REQUIRE(first.MoveNext());
+        REQUIRE(first.GetMany(array) == 2);
+        REQUIRE(array[0] == 2);
+        REQUIRE(array[1] == 3);
+        REQUIRE(!first.HasCurrent());
+    }
+
+    // Runs the readers until the writer is done. Catch assertions may only be made on the test's own thread, so
+    // readers instead return false on failure and the number of failed reads is returned.
+    template <typename Read, typename Write>
+    uint32_t run_contended(uint32_t const readers, Read read, Write write)
+    {
+        std::atomic<bool> done{};
+        std::atomic<uint32_t> failures{};
+        std::vector<std::thread> threads;
+
+        for (uint32_t index = 0; index < readers; ++index)
+        {
+            threads.emplace_back([&]
+            {
+                while (!done.load(std::memory_order_relaxed))
+                {
+                    if (!read())
+                    {
+                        ++failures;
+                    }
+                }
+            });
+        }
+
+        write();
+        done = true;
+
+        for (auto&& thread : threads)
+        {
+            thread.join();
+        }
+
+        return failures;
+    }
+}
+
+TEST_CASE("multi_threaded_vector - construction")
+{
+    IVector<int> values;
+
+    values = multi_threaded_vector<int>();
+    REQUIRE(values.Size() == 0);
+
+    values = multi_threaded_vector<int>({ 1,2,3 });
+    compare(values, { 1,2,3 });
+}
+
+TEST_CASE("test_multi_threaded_vector")
+{
+    IVector<int> values = multi_threaded_vector<int>();
+
+    REQUIRE_THROWS_AS(values.SetAt(0, 1), hresult_out_of_bounds);
+    values.InsertAt(0, 1);
+    values.InsertAt(0, 2);
+    values.Append(3);
+    compare(values, { 2,1,3 });
+
+    uint32_t index = 0;
+    REQUIRE(values.IndexOf(3, index));
+    REQUIRE(index == 2);
+    REQUIRE(!values.IndexOf(4, index));
+
+    values.SetAt(0, 0);
+    values.RemoveAt(1);
+    compare(values, { 0,3 });
+    values.RemoveAtEnd();
+    compare(values, { 0 });
+    values.Clear();
+    REQUIRE_THROWS_AS(values.RemoveAtEnd(), hresult_out_of_bounds);
+
+    values.ReplaceAll({ 1,2,3,4 });
+    compare(values, { 1,2,3,4 });
+    compare(values.GetView().as<IVector<int>>(), { 1,2,3,4 });
+
+    test_snapshot(values, [&] { values.Clear(); });
+    test_snapshot(values, [&] { values.SetAt(0, 0); });
+    test_snapshot(values, [&] { values.InsertAt(0, 0); });
+    test_snapshot(values, [&] { values.RemoveAt(0); });
+    test_snapshot(values, [&] { values.Append(0); });
+    test_snapshot(values, [&] { values.RemoveAtEnd(); });
+    test_snapshot(values, [&] { values.ReplaceAll({}); });
+}
+
+TEST_CASE("multi_threaded_vector - concurrency")
+{
+    IVector<int> values = multi_threaded_vector<int>(std::vector<int>(100, 0));
+
+    // Every write sets all elements to the same, increasing, value so readers can tell if they see a torn write.
+    uint32_t const failures = run_contended(4, [&]
+    {
+        int const expected = values.GetAt(0);
+
+        for (int value : values)
+        {
+            if (value < expected)
+            {
+                return false;
+            }
+        }
+
+        std::array<int, 100> array;
+        return values.Size() == 100 &&
+            values.GetMany(0, array) == 100 &&
+            std::adjacent_find(array.begin(), array.end(), std::not_equal_to<>()) == array.end();
+    },
+    [&]
+    {
+        for (int version = 1; version <= 1000; ++version)
+        {
+            std::vector<int> next(100, version);
+            values.ReplaceAll(next);
+        }
+    });
+
+    REQUIRE(failures == 0);
+    REQUIRE(values.GetAt(99) == 1000);
+}
+
+TEST_CASE("multi_threaded_vector - contention benchmark", "[.benchmark]")
+{
+    uint32_t const readers = (std::max)(2u, std::thread::hardware_concurrency()) - 1;
+    IVector<int> values = multi_threaded_vector<int>(std::vector<int>(1000, 1));
+
+    BENCHMARK("read-heavy: GetAt with one writer")
+    {
+        REQUIRE(run_contended(readers, [&] { return values.GetAt(500) != 0; }, [&]
+        {
+            for (uint32_t index = 0; index < 10'000; ++index)
+            {
+                values.SetAt(index % 1000, 1);
+            }
+        }) == 0);
+    }
+
+    BENCHMARK("read-heavy: iteration with one writer")
+    {
+        REQUIRE(run_contended(readers, [&] { return std::accumulate(begin(values), end(values), 0) == 1000; }, [&]
+        {
+            for (uint32_t index = 0; index < 1000; ++index)
+            {
+                values.SetAt(index, 1);
+            }
+        }) == 0);
+    }
+}
@@ -88,3 +88,95 @@ TEST_CASE("test_single_threaded_map")
 {
     test_map(single_threaded_map<int, int>());
 }
+
+TEST_CASE("single_threaded_map - ordered")
+{
+    IMap<int, int> values = single_threaded_map<int, int, std::greater<int>>();
+    test_map(values);
+
+    values.Insert(1, 10);
+    values.Insert(3, 30);
+    values.Insert(2, 20);
+    std::vector<int> keys;
+
+    for (auto pair : values)
+    {
+        keys.push_back(pair.Key());
+    }
+
+    REQUIRE(keys == std::vector<int>{ 3,2,1 });
+}
+
+TEST_CASE("single_threaded_map - flat_hash_map")
+{
+    impl::flat_hash_map<int, int> values;
+    std::map<int, int> expected;
+
+    // Keys that differ only in their upper bits land in the same place without a good hash.
+    for (int key = 0; key < 1000; ++key)
+    {
+        REQUIRE(values.insert_or_assign(key * 1024, key).second);
+        expected[key * 1024] = key;
+    }
+
+    REQUIRE(!values.insert_or_assign(0, -1).second);
+    expected[0] = -1;
+
+    for (int key = 0; key < 1000; key += 3)
+    {
+        REQUIRE(values.erase(key * 1024) == 1);
+        expected.erase(key * 1024);
+    }
+
+    REQUIRE(values.erase(1) == 0);
+    REQUIRE(values.size() == expected.size());
+
+    for (auto&& [key, value] : expected)
+    {
+        REQUIRE(values.find(key)->second == value);
+    }
+
+    REQUIRE(std::map<int, int>(values.begin(), values.end()) == expected);
+
+    values.clear();
+    REQUIRE(values.empty());
+    REQUIRE(values.find(1024) == values.end());
+}
+
+TEST_CASE("single_threaded_map - benchmark", "[.benchmark]")
+{
+    int const size = 100'000;
+
+    auto run = [&](IMap<int, int> const& values)
+    {
+        for (int key = 0; key < size; ++key)
+        {
+            values.Insert(key * 7, key);
+        }
+
+        int found = 0;
+
+        for (int key = 0; key < size; ++key)
+        {
+            found += values.Lookup(key * 7) == key;
+            found += values.HasKey(key * 7 + 1);
+        }
+
+        REQUIRE(found == size);
+    };
+
+    BENCHMARK("Insert, Lookup and HasKey with std::map")
+    {
+        run(single_threaded_map<int, int, std::less<int>>());
+    }
+
+    BENCHMARK("Insert, Lookup and HasKey with std::unordered_map")
+    {
+        run(single_threaded_map<int, int>(std::unordered_map<int, int>{}));
+    }
+
+    BENCHMARK("Insert, Lookup and HasKey with the default flat hash map")
+    {
+        run(single_threaded_map<int, int>());
+    }
+}
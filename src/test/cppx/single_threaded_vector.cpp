@@ -1,6 +1,7 @@
 #include "pch.h"
 #include "catch.hpp"
 #include <deque>
+#include <numeric>
 
 using namespace xlang;
 using namespace Foundation::Collections;
@@ -109,3 +110,169 @@ TEST_CASE("test_single_threaded_vector")
 {
     test_vector(single_threaded_vector<int>());
 }
+
+namespace
+{
+    struct element : implements<element, Windows::Foundation::IXlangObject>
+    {
+    };
+
+    template <typename T, typename F>
+    IVector<T> make_vector(uint32_t const size, F make_value)
+    {
+        std::vector<T> values;
+        values.reserve(size);
+
+        for (uint32_t index = 0; index != size; ++index)
+        {
+            values.push_back(make_value(index));
+        }
+
+        return single_threaded_vector<T>(std::move(values));
+    }
+
+    template <typename T>
+    uint32_t count_view(IVectorView<T> const& values)
+    {
+        uint32_t count{};
+
+        for (auto&& value : values)
+        {
+            count += value != T{};
+        }
+
+        return count;
+    }
+
+    template <typename T>
+    uint32_t count_iterable(IIterable<T> const& values)
+    {
+        uint32_t count{};
+
+        for (auto&& value : values)
+        {
+            count += value != T{};
+        }
+
+        return count;
+    }
+}
+
+TEST_CASE("single_threaded_vector - iteration")
+{
+    // Sizes around the chunk boundaries of the iterators.
+    for (uint32_t size : { 0, 1, 63, 64, 65, 1000 })
+    {
+        auto values = make_vector<int>(size, [](uint32_t index) { return static_cast<int>(index) + 1; });
+        std::vector<int> expected(size);
+        std::iota(expected.begin(), expected.end(), 1);
+
+        compare(values, std::vector<int>(expected));
+
+        auto const view = values.GetView();
+        REQUIRE(std::vector<int>(begin(view), end(view)) == expected);
+
+        auto const iterable = values.as<IIterable<int>>();
+        REQUIRE(std::vector<int>(begin(iterable), end(iterable)) == expected);
+
+        // Until it is used, the iterator of an iterable converts back to the IIterator it wraps.
+        IIterator<int> const iterator = begin(iterable);
+        REQUIRE((size == 0 ? iterator == nullptr : iterator.Current() == 1));
+    }
+
+    // Copies of an iterator read their own chunk, so advancing one doesn't disturb the other.
+    auto const view = make_vector<int>(100, [](uint32_t index) { return static_cast<int>(index) + 1; }).GetView();
+    auto first = begin(view);
+    auto copy = first;
+    REQUIRE(*first == 1);
+
+    for (uint32_t index = 0; index != 70; ++index)
+    {
+        ++copy;
+    }
+
+    REQUIRE(*copy == 71);
+    REQUIRE(*first == 1);
+
+    auto strings = make_vector<hstring>(100, [](uint32_t index) { return to_hstring(index); });
+    uint32_t index{};
+
+    for (auto&& value : strings.GetView())
+    {
+        REQUIRE(value == to_hstring(index++));
+    }
+
+    REQUIRE(index == 100);
+
+    auto objects = make_vector<Windows::Foundation::IXlangObject>(100, [](uint32_t) { return make<element>(); });
+    REQUIRE(count_view(objects.GetView()) == 100);
+    REQUIRE(count_iterable(objects.as<IIterable<Windows::Foundation::IXlangObject>>()) == 100);
+}
+
+TEST_CASE("single_threaded_vector - iteration benchmark", "[.benchmark]")
+{
+    uint32_t const size = 1'000'000;
+    auto ints = make_vector<int>(size, [](uint32_t index) { return static_cast<int>(index) + 1; }).GetView();
+    auto strings = make_vector<hstring>(size, [](uint32_t index) { return to_hstring(index); }).GetView();
+    auto objects = make_vector<Windows::Foundation::IXlangObject>(size, [](uint32_t) { return make<element>(); }).GetView();
+
+    BENCHMARK("iterate 1M ints")
+    {
+        REQUIRE(count_view(ints) == size);
+    }
+
+    BENCHMARK("iterate 1M strings")
+    {
+        REQUIRE(count_view(strings) == size);
+    }
+
+    BENCHMARK("iterate 1M objects")
+    {
+        REQUIRE(count_view(objects) == size);
+    }
+
+    BENCHMARK("iterate 1M ints through IIterable")
+    {
+        REQUIRE(count_iterable(ints.as<IIterable<int>>()) == size);
+    }
+}
+
+TEST_CASE("single_threaded_vector - buffer access")
+{
+    IVector<int> values = single_threaded_vector<int>({ 1,2,3 });
+    auto buffer = try_get_buffer(values);
+    REQUIRE(buffer);
+    REQUIRE(std::vector<int>(buffer.begin(), buffer.end()) == std::vector<int>{ 1,2,3 });
+    REQUIRE(buffer.is_current());
+
+    auto view = try_get_buffer(values.GetView());
+    REQUIRE(view.data() == buffer.data());
+
+    values.Append(4);
+    REQUIRE(!buffer.is_current());
+    REQUIRE_THROWS_AS(buffer.check_current(), hresult_changed_state);
+
+    buffer = try_get_buffer(values);
+    REQUIRE(buffer.size() == 4);
+    REQUIRE(buffer.is_current());
+}
+
+TEST_CASE("single_threaded_vector - buffer access benchmark", "[.benchmark]")
+{
+    uint32_t const size = 1'000'000;
+    auto values = make_vector<int>(size, [](uint32_t index) { return static_cast<int>(index) + 1; });
+    std::vector<int> copy(size);
+
+    BENCHMARK("read 1M ints with GetMany")
+    {
+        REQUIRE(values.GetMany(0, copy) == size);
+        REQUIRE(std::count(copy.begin(), copy.end(), 0) == 0);
+    }
+
+    BENCHMARK("read 1M ints in place")
+    {
+        auto buffer = try_get_buffer(values);
+        REQUIRE(std::count(buffer.begin(), buffer.end(), 0) == 0);
+        REQUIRE(buffer.is_current());
+    }
+}
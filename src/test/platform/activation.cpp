@@ -1,4 +1,6 @@
 #include "pch.h"
+#include <filesystem>
+#include <fstream>
 
 TEST_CASE("Simple activation")
 {
@@ -27,3 +29,179 @@ TEST_CASE("Simple activation")
         factory = nullptr;
     }
 }
+
+namespace
+{
+    xlang_result activate(std::u16string_view class_name)
+    {
+        xlang_string_header str_header{};
+        xlang_string str{};
+        REQUIRE(xlang_create_string_reference_utf16(class_name.data(), static_cast<uint32_t>(class_name.size()), &str_header, &str) == nullptr);
+
+        xlang_unknown* factory{};
+        xlang_error_info* result = xlang_get_activation_factory(str, xlang_unknown_guid, reinterpret_cast<void**>(&factory));
+        if (result)
+        {
+            xlang_result error{};
+            result->GetError(&error);
+            result->Release();
+            REQUIRE(factory == nullptr);
+            return error;
+        }
+
+        REQUIRE(factory != nullptr);
+        factory->Release();
+        return xlang_result::success;
+    }
+}
+
+TEST_CASE("Activation cache")
+{
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+
+    // Namespaces without a module are remembered too, and keep failing with the same error.
+    REQUIRE(activate(u"NoSuchComponent.Nested.Widget") == xlang_result::type_load);
+    REQUIRE(activate(u"NoSuchComponent.Nested.Widget") == xlang_result::type_load);
+
+    std::string_view namespace_name{ "AbiComponent" };
+    xlang_string_header str_header{};
+    xlang_string str{};
+    REQUIRE(xlang_create_string_reference_utf8(namespace_name.data(), static_cast<uint32_t>(namespace_name.size()), &str_header, &str) == nullptr);
+    REQUIRE(xlang_invalidate_activation_cache(str) == nullptr);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+
+    REQUIRE(xlang_invalidate_activation_cache(nullptr) == nullptr);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    REQUIRE(activate(u"NoSuchComponent.Nested.Widget") == xlang_result::type_load);
+}
+
+namespace
+{
+    xlang_result get_error(xlang_error_info* error_info)
+    {
+        if (!error_info)
+        {
+            return xlang_result::success;
+        }
+
+        xlang_result error{};
+        error_info->GetError(&error);
+        error_info->Release();
+        return error;
+    }
+
+    struct string_reference
+    {
+        explicit string_reference(std::string_view value)
+        {
+            REQUIRE(xlang_create_string_reference_utf8(value.data(), static_cast<uint32_t>(value.size()), &header, &str) == nullptr);
+        }
+
+        xlang_string_header header{};
+        xlang_string str{};
+    };
+
+#if XLANG_PLATFORM_WINDOWS
+    constexpr std::string_view abi_component_module{ "AbiComponent.dll" };
+#else
+    constexpr std::string_view abi_component_module{ "libAbiComponent.so" };
+#endif
+}
+
+TEST_CASE("Activation without error origination")
+{
+    xlang_unknown* factory{};
+    REQUIRE(xlang_try_get_activation_factory(nullptr, xlang_unknown_guid, reinterpret_cast<void**>(&factory)) == xlang_result::invalid_arg);
+    REQUIRE(factory == nullptr);
+
+    string_reference const widget{ "AbiComponent.Widget" };
+    REQUIRE(xlang_try_get_activation_factory(widget.str, xlang_unknown_guid, reinterpret_cast<void**>(&factory)) == xlang_result::success);
+    REQUIRE(factory != nullptr);
+    factory->Release();
+    factory = nullptr;
+
+    // Once the lookup is cached, probing for a missing class doesn't allocate.
+    string_reference const missing{ "NoSuchComponent.Widget" };
+    REQUIRE(xlang_try_get_activation_factory(missing.str, xlang_unknown_guid, reinterpret_cast<void**>(&factory)) == xlang_result::type_load);
+
+    xlang_mem_reset_statistics();
+    xlang_mem_enable_statistics(true);
+    REQUIRE(xlang_try_get_activation_factory(missing.str, xlang_unknown_guid, reinterpret_cast<void**>(&factory)) == xlang_result::type_load);
+    xlang_mem_enable_statistics(false);
+    REQUIRE(factory == nullptr);
+
+    xlang_mem_statistics statistics{};
+    xlang_mem_get_statistics(&statistics);
+    REQUIRE(statistics.allocation_count == 0);
+}
+
+TEST_CASE("Activation module registration")
+{
+    // Registrations are process-wide, so everything registered here is removed again before the test ends.
+    string_reference const current_directory{ "." };
+    REQUIRE(get_error(xlang_add_module_search_path(current_directory.str)) == xlang_result::success);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    REQUIRE(get_error(xlang_remove_module_search_path(current_directory.str)) == xlang_result::success);
+
+    string_reference const missing_namespace{ "NoSuchComponent" };
+    REQUIRE(get_error(xlang_register_activation_module(nullptr, nullptr, false)) == xlang_result::invalid_arg);
+    REQUIRE(get_error(xlang_register_activation_module(
+        missing_namespace.str,
+        string_reference{ "NoSuchComponent.module" }.str,
+        true)) == xlang_result::type_load);
+    REQUIRE(activate(u"NoSuchComponent.Nested.Widget") == xlang_result::type_load);
+    REQUIRE(get_error(xlang_unregister_activation_module(missing_namespace.str)) == xlang_result::success);
+
+    REQUIRE(get_error(xlang_load_activation_manifest(string_reference{ "no_such_manifest.txt" }.str, false)) == xlang_result::invalid_arg);
+
+    // The manifest is loaded by a bare file name from its own directory. Its entry is relative to that
+    // directory, so it must still resolve once the current directory has changed back.
+    std::filesystem::path const original_directory{ std::filesystem::current_path() };
+    std::filesystem::path const manifest_directory{ "activation_manifest_test" };
+    std::filesystem::create_directory(manifest_directory);
+    {
+        std::ofstream manifest{ manifest_directory / "malformed_manifest.txt" };
+        manifest << "AbiComponent\n";
+    }
+    {
+        std::ofstream manifest{ manifest_directory / "activation_manifest.txt" };
+        manifest << "# Test components\n";
+        manifest << "\n";
+        manifest << "  AbiComponent = " << (std::filesystem::path{ ".." } / abi_component_module).string() << "\r\n";
+    }
+
+    std::filesystem::current_path(manifest_directory);
+    xlang_result const malformed_result = get_error(xlang_load_activation_manifest(string_reference{ "malformed_manifest.txt" }.str, false));
+    xlang_result const manifest_result = get_error(xlang_load_activation_manifest(string_reference{ "activation_manifest.txt" }.str, false));
+    std::filesystem::current_path(original_directory);
+
+    REQUIRE(malformed_result == xlang_result::invalid_arg);
+    REQUIRE(manifest_result == xlang_result::success);
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+    REQUIRE(get_error(xlang_unregister_activation_module(string_reference{ "AbiComponent" }.str)) == xlang_result::success);
+
+    std::filesystem::remove_all(manifest_directory);
+}
+
+TEST_CASE("Activation cache,benchmark", "[.benchmark]")
+{
+    REQUIRE(activate(u"AbiComponent.Widget") == xlang_result::success);
+
+    BENCHMARK("Repeated activation")
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            activate(u"AbiComponent.Widget");
+        }
+    }
+
+    BENCHMARK("Repeated activation after invalidation")
+    {
+        for (int i = 0; i < 10000; ++i)
+        {
+            xlang_invalidate_activation_cache(nullptr);
+            activate(u"AbiComponent.Widget");
+        }
+    }
+}
\ No newline at end of file
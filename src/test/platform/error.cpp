@@ -211,4 +211,193 @@ TEST_CASE("Error origination with all parameters")
     propagated_error = nullptr;
     REQUIRE(result->Release() == 0);
     result = nullptr;
+}
+
+TEST_CASE("Lightweight error origination")
+{
+    xlang_set_error_origination(xlang_error_origination::lightweight);
+
+    INFO("Errors without details share an error info");
+    xlang_error_info* first = xlang_originate_error(xlang_result::type_load);
+    xlang_error_info* second = xlang_originate_error(xlang_result::type_load);
+    REQUIRE(first != nullptr);
+    REQUIRE(first == second);
+    verify_error_info(first, xlang_result::type_load);
+
+    xlang_error_info* other = xlang_originate_error(xlang_result::no_interface);
+    REQUIRE(other != first);
+    verify_error_info(other, xlang_result::no_interface);
+
+    INFO("Shared error infos don't record propagation");
+    first->PropagateError(nullptr, nullptr, nullptr, nullptr);
+    verify_error_info(second, xlang_result::type_load);
+
+    INFO("Errors with details are still originated individually");
+    basic_string_view<xlang_char8> str = "This is a detailed error";
+    xlang_string message{};
+    REQUIRE(xlang_create_string_utf8(str.data(), str.size(), &message) == nullptr);
+    xlang_error_info* detailed = xlang_originate_error(xlang_result::type_load, message);
+    REQUIRE(detailed != first);
+    verify_error_info(detailed, xlang_result::type_load, message);
+    REQUIRE(detailed->Release() == 0);
+
+    other->Release();
+    second->Release();
+    first->Release();
+
+    xlang_set_error_origination(xlang_error_origination::rich);
+    xlang_error_info* rich = xlang_originate_error(xlang_result::type_load);
+    REQUIRE(rich != first);
+    REQUIRE(rich->Release() == 0);
+}
+
+TEST_CASE("Error statistics")
+{
+    xlang_reset_error_statistics();
+
+    xlang_error_info* first = xlang_originate_error(xlang_result::not_impl);
+    xlang_error_info* second = xlang_originate_error(xlang_result::not_impl);
+
+    xlang_error_statistics statistics{};
+    REQUIRE(xlang_get_error_statistics(xlang_result::not_impl, &statistics) == nullptr);
+    REQUIRE(statistics.originated_count == 2);
+    REQUIRE(statistics.traced_count == 0);
+
+    REQUIRE(xlang_get_error_statistics(xlang_result::bounds, &statistics) == nullptr);
+    REQUIRE(statistics.originated_count == 0);
+
+    xlang_reset_error_statistics();
+    REQUIRE(xlang_get_error_statistics(xlang_result::not_impl, &statistics) == nullptr);
+    REQUIRE(statistics.originated_count == 0);
+
+    xlang_error_info* invalid = xlang_get_error_statistics(static_cast<xlang_result>(1000), &statistics);
+    REQUIRE(invalid != nullptr);
+    verify_error_info(invalid, xlang_result::invalid_arg);
+    invalid->Release();
+
+    second->Release();
+    first->Release();
+}
+
+namespace
+{
+    uint32_t XLANG_CALL capture_test_stack(void* context, void** frames, uint32_t max_frame_count)
+    {
+        auto& capture_count = *static_cast<uint32_t*>(context);
+        ++capture_count;
+        for (uint32_t i = 0; i < max_frame_count; ++i)
+        {
+            frames[i] = reinterpret_cast<void*>(static_cast<uintptr_t>(i + 1));
+        }
+        return max_frame_count;
+    }
+
+    uint32_t XLANG_CALL capture_no_frames(void* context, void**, uint32_t)
+    {
+        ++*static_cast<uint32_t*>(context);
+        return 0;
+    }
+
+    uint32_t get_frame_count(xlang_error_info* error_info)
+    {
+        xlang_unknown* trace{};
+        error_info->GetExecutionTrace(&trace);
+        if (!trace)
+        {
+            return 0;
+        }
+
+        xlang_execution_trace* execution_trace{};
+        REQUIRE(trace->QueryInterface(xlang_execution_trace_guid, reinterpret_cast<void**>(&execution_trace)) == 0);
+        trace->Release();
+
+        void* const* frames{};
+        uint32_t frame_count{};
+        execution_trace->GetFrames(&frames, &frame_count);
+        REQUIRE(frame_count != 0);
+        REQUIRE(frames != nullptr);
+        execution_trace->Release();
+        return frame_count;
+    }
+}
+
+TEST_CASE("Error execution traces")
+{
+    xlang_reset_error_statistics();
+
+    INFO("Options are validated");
+    xlang_error_trace_options options{};
+    xlang_error_info* invalid = xlang_set_error_trace_options(&options);
+    REQUIRE(invalid != nullptr);
+    REQUIRE(get_frame_count(invalid) == 0);
+    invalid->Release();
+
+    INFO("Traces are sampled");
+    uint32_t capture_count{};
+    options.capture_stack = capture_test_stack;
+    options.context = &capture_count;
+    options.max_frame_count = 8;
+    options.sample_interval = 2;
+    REQUIRE(xlang_set_error_trace_options(&options) == nullptr);
+
+    uint32_t traced{};
+    for (int i = 0; i < 4; ++i)
+    {
+        xlang_error_info* error_info = xlang_originate_error(xlang_result::handle);
+        uint32_t const frame_count = get_frame_count(error_info);
+        REQUIRE((frame_count == 0 || frame_count == 8));
+        traced += frame_count != 0;
+        error_info->Release();
+    }
+    REQUIRE(traced == 2);
+    REQUIRE(capture_count == 2);
+
+    xlang_error_statistics statistics{};
+    REQUIRE(xlang_get_error_statistics(xlang_result::handle, &statistics) == nullptr);
+    REQUIRE(statistics.originated_count == 4);
+    REQUIRE(statistics.traced_count == 2);
+
+    INFO("Traces are rate limited");
+    options.sample_interval = 0;
+    options.max_traces_per_second = 1;
+    REQUIRE(xlang_set_error_trace_options(&options) == nullptr);
+    capture_count = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        xlang_originate_error(xlang_result::handle)->Release();
+    }
+    REQUIRE(capture_count >= 1);
+    REQUIRE(capture_count <= 2);
+
+    INFO("Captures without frames are neither attached nor counted");
+    options.capture_stack = capture_no_frames;
+    options.max_traces_per_second = 0;
+    REQUIRE(xlang_set_error_trace_options(&options) == nullptr);
+    xlang_reset_error_statistics();
+    capture_count = 0;
+    for (int i = 0; i < 2; ++i)
+    {
+        xlang_error_info* error_info = xlang_originate_error(xlang_result::handle);
+        REQUIRE(get_frame_count(error_info) == 0);
+        error_info->Release();
+    }
+    REQUIRE(capture_count == 2);
+    REQUIRE(xlang_get_error_statistics(xlang_result::handle, &statistics) == nullptr);
+    REQUIRE(statistics.originated_count == 2);
+    REQUIRE(statistics.traced_count == 0);
+
+    INFO("The platform unwinder is used by default");
+    options = {};
+    options.max_frame_count = 16;
+    REQUIRE(xlang_set_error_trace_options(&options) == nullptr);
+    xlang_error_info* error_info = xlang_originate_error(xlang_result::handle);
+    uint32_t const frame_count = get_frame_count(error_info);
+    REQUIRE(frame_count > 0);
+    REQUIRE(frame_count <= 16);
+    error_info->Release();
+
+    REQUIRE(xlang_set_error_trace_options(nullptr) == nullptr);
+    error_info = xlang_originate_error(xlang_result::handle);
+    REQUIRE(get_frame_count(error_info) == 0);
+    error_info->Release();
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "pch.h"
+#include <cstdlib>
 
 struct MemGuard
 {
@@ -57,3 +58,112 @@ TEST_CASE("Mem alloc")
         // This will also check xlang_mem_free with null
     }
 }
+
+struct counting_allocator
+{
+    static void* XLANG_CALL alloc(void* context, size_t count)
+    {
+        auto self = static_cast<counting_allocator*>(context);
+        ++self->alloc_count;
+        return ::malloc(count);
+    }
+
+    static void XLANG_CALL free(void* context, void* ptr)
+    {
+        auto self = static_cast<counting_allocator*>(context);
+        ++self->free_count;
+        ::free(ptr);
+    }
+
+    static void XLANG_CALL free_sized(void* context, void* ptr, size_t count)
+    {
+        auto self = static_cast<counting_allocator*>(context);
+        ++self->free_sized_count;
+        self->last_free_size = count;
+        ::free(ptr);
+    }
+
+    uint32_t alloc_count{};
+    uint32_t free_count{};
+    uint32_t free_sized_count{};
+    size_t last_free_size{};
+};
+
+TEST_CASE("Mem allocator hooks")
+{
+    counting_allocator counter;
+    xlang_mem_allocator allocator{ &counter, &counting_allocator::alloc, &counting_allocator::free, nullptr };
+
+    SECTION("Missing callbacks are rejected")
+    {
+        xlang_mem_allocator invalid{ &counter, &counting_allocator::alloc, nullptr, nullptr };
+        xlang_error_info* result = xlang_mem_set_allocator(&invalid);
+        REQUIRE(result != nullptr);
+        result->Release();
+    }
+    SECTION("Allocations are routed through the installed allocator")
+    {
+        REQUIRE(xlang_mem_set_allocator(&allocator) == nullptr);
+        {
+            MemGuard ptr1{ xlang_mem_alloc(16) };
+            MemGuard ptr2{ xlang_mem_alloc(0) };
+            REQUIRE(ptr1.m_ptr != nullptr);
+            REQUIRE(ptr2.m_ptr != nullptr);
+        }
+        REQUIRE(xlang_mem_set_allocator(nullptr) == nullptr);
+
+        REQUIRE(counter.alloc_count == 2);
+        REQUIRE(counter.free_count == 2);
+    }
+    SECTION("Sized free falls back to free when not provided")
+    {
+        REQUIRE(xlang_mem_set_allocator(&allocator) == nullptr);
+        xlang_mem_free_sized(xlang_mem_alloc(32), 32);
+
+        allocator.free_sized = &counting_allocator::free_sized;
+        REQUIRE(xlang_mem_set_allocator(&allocator) == nullptr);
+        xlang_mem_free_sized(xlang_mem_alloc(32), 32);
+        REQUIRE(xlang_mem_set_allocator(nullptr) == nullptr);
+
+        REQUIRE(counter.alloc_count == 2);
+        REQUIRE(counter.free_count == 1);
+        REQUIRE(counter.free_sized_count == 1);
+        REQUIRE(counter.last_free_size == 32);
+    }
+    SECTION("Error infos use the installed allocator")
+    {
+        REQUIRE(xlang_mem_set_allocator(&allocator) == nullptr);
+        xlang_error_info* result = xlang_originate_error(xlang_result::fail);
+        REQUIRE(result != nullptr);
+        REQUIRE(result->Release() == 0);
+        REQUIRE(xlang_mem_set_allocator(nullptr) == nullptr);
+
+        REQUIRE(counter.alloc_count == 1);
+        REQUIRE(counter.free_count == 1);
+    }
+}
+
+TEST_CASE("Mem statistics")
+{
+    xlang_mem_reset_statistics();
+    xlang_mem_enable_statistics(true);
+
+    xlang_mem_free(xlang_mem_alloc(10));
+    xlang_mem_free(xlang_mem_alloc(20));
+    xlang_mem_free(xlang_mem_alloc(std::numeric_limits<size_t>::max()));
+
+    xlang_mem_enable_statistics(false);
+    xlang_mem_free(xlang_mem_alloc(40));
+
+    xlang_mem_statistics statistics{};
+    xlang_mem_get_statistics(&statistics);
+    REQUIRE(statistics.allocation_count == 2);
+    REQUIRE(statistics.failed_allocation_count == 1);
+    REQUIRE(statistics.free_count == 2);
+    REQUIRE(statistics.bytes_allocated == 30);
+
+    xlang_mem_reset_statistics();
+    xlang_mem_get_statistics(&statistics);
+    REQUIRE(statistics.allocation_count == 0);
+    REQUIRE(statistics.bytes_allocated == 0);
+}
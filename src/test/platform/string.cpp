@@ -1,5 +1,7 @@
 #include "pch.h"
 #include "string_helpers.h"
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace std::string_view_literals;
@@ -508,3 +510,333 @@ TEST_CASE("Convert UTF-16 string reference")
 {
     convert_string_reference<char16_t>();
 }
+
+template <typename char_type, typename requested_type>
+basic_string<requested_type> copy_in_chunks(xlang_string str, uint32_t chunk_length)
+{
+    basic_string<requested_type> copy;
+    xlang_string_cursor cursor{};
+    requested_type buffer[16]{};
+    REQUIRE(chunk_length <= std::size(buffer));
+
+    uint32_t copied{};
+    do
+    {
+        xlang_error_info* result = xlang_copy_string<requested_type>(str, &cursor, buffer, chunk_length, &copied);
+        REQUIRE(result == nullptr);
+        copy.append(buffer, copied);
+    } while (copied != 0);
+
+    return copy;
+}
+
+template <typename char_type>
+void copy_string()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    for (size_t i = 0; i < std::size(valid_strings<char_type>::value); ++i)
+    {
+        auto const test_string = valid_strings<char_type>::value[i];
+        auto const other_string = valid_strings<other_type>::value[i];
+        xlang_string str{};
+        REQUIRE(xlang_create_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+
+        {
+            INFO("Measure the string in both encodings");
+            uint32_t length{};
+            REQUIRE(xlang_get_string_length<char_type>(str, &length) == nullptr);
+            REQUIRE(length == test_string.size());
+            REQUIRE(xlang_get_string_length<other_type>(str, &length) == nullptr);
+            REQUIRE(length == other_string.size());
+        }
+
+        {
+            INFO("Copy the string in chunks without caching the other encoding");
+            for (uint32_t chunk_length : { 4u, 5u, 16u })
+            {
+                REQUIRE(copy_in_chunks<char_type, char_type>(str, chunk_length) == test_string);
+                REQUIRE(copy_in_chunks<char_type, other_type>(str, chunk_length) == other_string);
+            }
+            REQUIRE((str == nullptr || !has_encoding<other_type>(str)));
+        }
+
+        {
+            INFO("Copy the string after the other encoding has been cached");
+            other_type const* buffer{};
+            uint32_t length{};
+            REQUIRE(xlang_get_string_raw_buffer<other_type>(str, &buffer, &length) == nullptr);
+            REQUIRE(copy_in_chunks<char_type, other_type>(str, 4) == other_string);
+        }
+
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("Strings below the cache threshold keep the converted copy");
+        auto const test_string = valid_strings<char_type>::value[2];
+        xlang_string str{};
+        REQUIRE(xlang_create_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+        xlang_set_string_cache_threshold(static_cast<uint32_t>(test_string.size()));
+        REQUIRE(copy_in_chunks<char_type, other_type>(str, 4) == valid_strings<other_type>::value[2]);
+        xlang_set_string_cache_threshold(0);
+        REQUIRE(has_encoding<other_type>(str));
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("A buffer too small to hold a single code point is rejected");
+        auto const test_string = valid_strings<char_type>::value[std::size(valid_strings<char_type>::value) - 1];
+        xlang_string str{};
+        REQUIRE(xlang_create_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+        xlang_string_cursor cursor{};
+        char_type buffer[1]{};
+        uint32_t copied{};
+        xlang_error_info* result = xlang_copy_string<char_type>(str, &cursor, buffer, 1, &copied);
+        REQUIRE(result != nullptr);
+        REQUIRE(copied == 0);
+        result->Release();
+        xlang_delete_string(str);
+    }
+
+    for (auto const& test_string : invalid_strings<char_type>::value)
+    {
+        xlang_string str{};
+        REQUIRE(xlang_create_string(test_string.data(), static_cast<uint32_t>(test_string.size()), &str) == nullptr);
+
+        xlang_string_cursor cursor{};
+        other_type buffer[16]{};
+        uint32_t copied{};
+        xlang_error_info* result = xlang_copy_string<other_type>(str, &cursor, buffer, 16, &copied);
+        REQUIRE(result != nullptr);
+        xlang_result error_code{};
+        result->GetError(&error_code);
+        REQUIRE(error_code == xlang_result::invalid_arg);
+        result->Release();
+
+        xlang_delete_string(str);
+    }
+}
+
+TEST_CASE("Copy UTF-8 string")
+{
+    copy_string<xlang_char8>();
+}
+
+TEST_CASE("Copy UTF-16 string")
+{
+    copy_string<char16_t>();
+}
+
+template <typename char_type>
+void duplicate_string_reference()
+{
+    using other_type = typename alternate_type<char_type>::type;
+    auto const test_string = valid_strings<char_type>::value[2];
+    xlang_string str_ref{};
+    xlang_string_header header{};
+    REQUIRE(xlang_create_string_reference<char_type>(test_string.data(), static_cast<uint32_t>(test_string.size()), &header, &str_ref) == nullptr);
+
+    xlang_string first{};
+    xlang_string second{};
+    {
+        INFO("Repeated duplicates of a string reference share one copy");
+        REQUIRE(xlang_duplicate_string(str_ref, &first) == nullptr);
+        REQUIRE(xlang_duplicate_string(str_ref, &second) == nullptr);
+        REQUIRE(first != str_ref);
+        REQUIRE(first == second);
+    }
+
+    {
+        INFO("Converting the reference after promotion caches the alternate on the copy");
+        other_type const* buffer_ref{};
+        uint32_t length_ref{};
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(str_ref, &buffer_ref, &length_ref) == nullptr);
+        REQUIRE(has_encoding<other_type>(first));
+
+        other_type const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<other_type>(first, &buffer, &length) == nullptr);
+        REQUIRE(buffer == buffer_ref);
+        REQUIRE(length == length_ref);
+    }
+
+    {
+        INFO("The copy outlives the string reference");
+        xlang_delete_string(str_ref);
+        xlang_delete_string(second);
+
+        char_type const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer<char_type>(first, &buffer, &length) == nullptr);
+        REQUIRE(test_string == basic_string_view<char_type>{ buffer, length });
+        REQUIRE(buffer != test_string.data());
+        xlang_delete_string(first);
+    }
+}
+
+TEST_CASE("Duplicate UTF-8 string reference")
+{
+    duplicate_string_reference<xlang_char8>();
+}
+
+TEST_CASE("Duplicate UTF-16 string reference")
+{
+    duplicate_string_reference<char16_t>();
+}
+
+TEST_CASE("Short strings reuse their blocks")
+{
+    auto create = [](basic_string_view<xlang_char8> value)
+    {
+        xlang_string result{};
+        REQUIRE(xlang_create_string_utf8(value.data(), static_cast<uint32_t>(value.size()), &result) == nullptr);
+        return result;
+    };
+
+    // Warm up the cache of this thread.
+    xlang_delete_string(create(u8"key"sv));
+
+    xlang_mem_reset_statistics();
+    xlang_mem_enable_statistics(true);
+
+    for (uint32_t i = 0; i != 1000; ++i)
+    {
+        xlang_string str = create(u8"PropertyName"sv);
+        xlang_delete_string(str);
+    }
+
+    // Strings released on another thread go to that thread's cache instead.
+    std::vector<xlang_string> strings;
+
+    for (uint32_t i = 0; i != 10; ++i)
+    {
+        strings.push_back(create(u8"Id"sv));
+    }
+
+    std::thread([&]
+    {
+        for (xlang_string str : strings)
+        {
+            xlang_delete_string(str);
+        }
+    }).join();
+
+    xlang_mem_enable_statistics(false);
+    xlang_mem_statistics statistics{};
+    xlang_mem_get_statistics(&statistics);
+    REQUIRE(statistics.allocation_count <= 10);
+
+    {
+        INFO("Long strings still go to the allocator");
+        basic_string<xlang_char8> const long_value(1000, u8'x');
+        xlang_string str = create(long_value);
+        xlang_char8 const* buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf8(str, &buffer, &length) == nullptr);
+        REQUIRE(basic_string_view<xlang_char8>(buffer, length) == long_value);
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("A preallocated buffer promoted to a short string");
+        xlang_char8* buffer{};
+        xlang_string_buffer buffer_handle{};
+        REQUIRE(xlang_preallocate_string_buffer_utf8(100, &buffer, &buffer_handle) == nullptr);
+        std::fill(buffer, buffer + 100, u8'y');
+        xlang_string str{};
+        REQUIRE(xlang_promote_string_buffer(buffer_handle, &str, 2) == nullptr);
+        xlang_delete_string(str);
+
+        xlang_string reused = create(u8"reused"sv);
+        xlang_char8 const* reused_buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf8(reused, &reused_buffer, &length) == nullptr);
+        REQUIRE(basic_string_view<xlang_char8>(reused_buffer, length) == u8"reused"sv);
+        xlang_delete_string(reused);
+    }
+}
+
+TEST_CASE("Short strings created after the cache is gone use whole blocks")
+{
+    // Destroyed after the string cache of its thread, since it is constructed first.
+    struct late_string
+    {
+        xlang_string* result{};
+
+        ~late_string()
+        {
+            auto const value = u8"PropertyName"sv;
+            xlang_create_string_utf8(value.data(), static_cast<uint32_t>(value.size()), result);
+        }
+    };
+
+    xlang_string str{};
+    xlang_mem_reset_statistics();
+
+    std::thread([&]
+    {
+        static thread_local late_string late;
+        late.result = &str;
+
+        xlang_string warm_up{};
+        REQUIRE(xlang_create_string_utf8(u8"key"sv.data(), 3, &warm_up) == nullptr);
+        xlang_delete_string(warm_up);
+
+        xlang_mem_enable_statistics(true);
+    }).join();
+
+    xlang_mem_enable_statistics(false);
+    xlang_mem_statistics statistics{};
+    xlang_mem_get_statistics(&statistics);
+    REQUIRE(str != nullptr);
+    REQUIRE(statistics.allocation_count == 1);
+    REQUIRE(statistics.bytes_allocated % 16 == 0);
+
+    // The block is filed under its size class here and may be handed to any string of that class.
+    xlang_delete_string(str);
+}
+
+TEST_CASE("Static strings are never freed")
+{
+    struct utf16_block
+    {
+        xlang_static_string_utf16 header;
+        char16_t buffer[8];
+    };
+    static utf16_block const utf16{ { 0, 7 }, { u'S', u't', u'a', u't', u'i', u'c', u'é', 0 } };
+    static xlang_static_string_header const header{ xlang_static_string_flags, 8, { &utf16 }, u8"Staticé" };
+    xlang_string const str = reinterpret_cast<xlang_string>(const_cast<xlang_static_string_header*>(&header));
+
+    {
+        INFO("Duplicating returns the same string");
+        xlang_string copy{};
+        REQUIRE(xlang_duplicate_string(str, &copy) == nullptr);
+        REQUIRE(copy == str);
+        xlang_delete_string(copy);
+        xlang_delete_string(str);
+    }
+
+    {
+        INFO("Both encodings are available without allocating");
+        xlang_mem_reset_statistics();
+        xlang_mem_enable_statistics(true);
+
+        REQUIRE(has_encoding<xlang_char8>(str));
+        REQUIRE(has_encoding<char16_t>(str));
+
+        xlang_char8 const* utf8_buffer{};
+        uint32_t length{};
+        REQUIRE(xlang_get_string_raw_buffer_utf8(str, &utf8_buffer, &length) == nullptr);
+        REQUIRE(basic_string_view<xlang_char8>(utf8_buffer, length) == u8"Staticé"sv);
+
+        char16_t const* utf16_buffer{};
+        REQUIRE(xlang_get_string_raw_buffer_utf16(str, &utf16_buffer, &length) == nullptr);
+        REQUIRE(basic_string_view<char16_t>(utf16_buffer, length) == u"Staticé"sv);
+        REQUIRE(utf16_buffer == utf16.buffer);
+
+        xlang_mem_enable_statistics(false);
+        xlang_mem_statistics statistics{};
+        xlang_mem_get_statistics(&statistics);
+        REQUIRE(statistics.allocation_count == 0);
+    }
+}
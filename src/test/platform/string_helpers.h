@@ -57,3 +57,31 @@ auto xlang_preallocate_string_buffer(uint32_t length, char_type** char_buffer, x
         return xlang_preallocate_string_buffer_utf16(length, char_buffer, buffer_handle);
     }
 }
+
+template <typename char_type>
+auto xlang_get_string_length(xlang_string str, uint32_t* length)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_get_string_length_utf8(str, length);
+    }
+    else
+    {
+        return xlang_get_string_length_utf16(str, length);
+    }
+}
+
+template <typename char_type>
+auto xlang_copy_string(xlang_string str, xlang_string_cursor* cursor, char_type* buffer, uint32_t buffer_length, uint32_t* copied_length)
+{
+    static_assert(std::disjunction_v<std::is_same<char_type, xlang_char8>, std::is_same<char_type, char16_t>>);
+    if constexpr (std::is_same_v<char_type, xlang_char8>)
+    {
+        return xlang_copy_string_utf8(str, cursor, buffer, buffer_length, copied_length);
+    }
+    else
+    {
+        return xlang_copy_string_utf16(str, cursor, buffer, buffer_length, copied_length);
+    }
+}
@@ -109,6 +109,13 @@ namespace xlang
         w.write(format);
     }
 
+    static void write_xlang_namespace(writer& w)
+    {
+        w.write(R"(namespace xlang
+{
+)");
+    }
+
     static void write_std_namespace(writer& w)
     {
         w.write(R"(namespace std
@@ -677,6 +684,49 @@ namespace xlang
 )");
     }
 
+    static void write_bulk_properties_field_abi(writer& w, MethodDef const& method)
+    {
+        method_signature signature{ method };
+        w.write("        % %;\n", signature.return_signature(), get_name(method));
+    }
+
+    static void write_bulk_properties_abi(writer& w, TypeDef const& type)
+    {
+        if (!has_bulk_properties(type))
+        {
+            return;
+        }
+
+        auto format = R"(    struct struct_bulk_properties_%
+    {
+%    };
+    template <> struct abi<bulk_properties<%>>
+    {
+        using type = struct_bulk_properties_%;
+    };
+    template <> struct bulk_properties_abi<%>
+    {
+        struct XLANG_NOVTABLE type : unknown_abi
+        {
+            virtual int32_t XLANG_CALL GetBulkProperties(struct_bulk_properties_%* value) noexcept = 0;
+        };
+    };
+)";
+
+        auto impl_name = get_impl_name(type.TypeNamespace(), type.TypeName());
+        w.abi_types = true;
+        auto fields = w.write_temp("%", bind_each<write_bulk_properties_field_abi>(get_bulk_properties(type)));
+        w.abi_types = false;
+
+        w.write(format,
+            impl_name,
+            fields,
+            type,
+            impl_name,
+            type,
+            impl_name);
+    }
+
     static void write_delegate_abi(writer& w, TypeDef const& type)
     {
         auto format = R"(    template <%> struct abi<%>
@@ -953,6 +1003,11 @@ namespace xlang
         }
     }
 
+    static void write_consume_bulk_properties_fallback(writer& w, MethodDef const& method)
+    {
+        w.write("\n            value.% = this->%();", get_name(method), get_name(method));
+    }
+
     static void write_consume_definitions(writer& w, TypeDef const& type)
     {
         auto generics = type.GenericParam();
@@ -1027,6 +1082,26 @@ namespace xlang
                     bind<write_consume_args>(signature));
             }
         }
+
+        if (has_bulk_properties(type))
+        {
+            auto format = R"(    template <typename D> bulk_properties<%> consume_%<D>::GetBulkProperties() const
+    {
+        bulk_properties<%> value;
+        if (!try_get_bulk_properties(XLANG_SHIM(%), value))
+        {%
+        }
+        return value;
+    }
+)";
+
+            w.write(format,
+                type,
+                type_impl_name,
+                type,
+                type,
+                bind_each<write_consume_bulk_properties_fallback>(get_bulk_properties(type)));
+        }
     }
 
     static void write_consume_extensions(writer& w, TypeDef const& type)
@@ -1168,6 +1243,14 @@ namespace xlang
         }
     }
 
+    static void write_consume_bulk_properties_declaration(writer& w, TypeDef const& type)
+    {
+        if (has_bulk_properties(type))
+        {
+            w.write("        bulk_properties<%> GetBulkProperties() const;\n", type);
+        }
+    }
+
     static void write_consume(writer& w, TypeDef const& type)
     {
         w.abi_types = false;
@@ -1188,7 +1271,7 @@ namespace xlang
             auto format = R"(    template <typename D>
     struct consume_%
     {
-%%    };
+%%%    };
     template <> struct consume<%>
     {
         template <typename D> using type = consume_%<D>;
@@ -1199,6 +1282,7 @@ namespace xlang
             w.write(format,
                 impl_name,
                 bind_each<write_consume_declaration>(type.MethodList()),
+                bind<write_consume_bulk_properties_declaration>(type),
                 bind<write_consume_extensions>(type),
                 type,
                 impl_name);
@@ -1551,12 +1635,49 @@ namespace xlang
             bind<write_produce_upcall>(method, signature));
     }
 
+    static void write_produce_bulk_properties_upcall(writer& w, MethodDef const& method)
+    {
+        w.write("\n                this->shim().%(),", get_name(method));
+    }
+
+    // The properties are constructed in place rather than detached from a temporary, which would copy the struct. A
+    // property that throws leaves the struct zeroed, as those before it have already been destroyed.
+    static void write_produce_bulk_properties(writer& w, TypeDef const& type)
+    {
+        if (!has_bulk_properties(type))
+        {
+            return;
+        }
+
+        auto format = R"(        int32_t XLANG_CALL GetBulkProperties(struct_bulk_properties_%* value) noexcept final try
+        {
+            typename D::abi_guard guard(this->shim());
+            ::new (value) bulk_properties<%>{%
+            };
+            return 0;
+        }
+        catch (...)
+        {
+            zero_abi<bulk_properties<%>>(value);
+            return to_hresult();
+        }
+)";
+
+        w.abi_types = false;
+
+        w.write(format,
+            get_impl_name(type.TypeNamespace(), type.TypeName()),
+            type,
+            bind_each<write_produce_bulk_properties_upcall>(get_bulk_properties(type)),
+            type);
+    }
+
     static void write_produce(writer& w, TypeDef const& type)
     {
         auto format = R"(    template <typename D%>
-    struct produce<D, %> : produce_base<D, %>
+    struct produce<D, %> : %<D, %>
     {
-%    };
+%%    };
 )";
 
         auto generics = type.GenericParam();
@@ -1565,8 +1686,10 @@ namespace xlang
         w.write(format,
             bind<write_comma_generic_typenames>(generics),
             type,
+            has_bulk_properties(type) ? "produce_bulk_properties_base" : "produce_base",
             type,
-            bind_each<write_produce_method>(type.MethodList()));
+            bind_each<write_produce_method>(type.MethodList()),
+            bind<write_produce_bulk_properties>(type));
     }
 
     static void write_dispatch_overridable_method(writer& w, MethodDef const& method)
@@ -2235,6 +2358,50 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
         }
     }
 
+    // The projected properties struct is written with the classes, once the types of its fields are complete. Like
+    // write_structs, returns whether it needs types from other namespaces to be complete.
+    static bool write_bulk_properties(writer& w, std::vector<TypeDef> const& types)
+    {
+        auto format = R"(    template <> struct bulk_properties<%>
+    {
+%    };
+)";
+
+        bool promote = false;
+        auto cpp_namespace = w.write_temp("@", w.type_namespace);
+
+        for (auto&& type : types)
+        {
+            if (!has_bulk_properties(type))
+            {
+                continue;
+            }
+
+            w.abi_types = false;
+            std::vector<std::pair<std::string_view, std::string>> fields;
+
+            for (auto&& method : get_bulk_properties(type))
+            {
+                method_signature signature{ method };
+                fields.emplace_back(get_name(method), w.write_temp("%", signature.return_signature()));
+            }
+
+            w.write(format,
+                type,
+                bind_each<write_struct_field>(fields));
+
+            for (auto&& field : fields)
+            {
+                if (field.second.find(':') != std::string::npos && !starts_with(field.second, cpp_namespace))
+                {
+                    promote = true;
+                }
+            }
+        }
+
+        return promote;
+    }
+
     static bool write_structs(writer& w, std::vector<TypeDef> const& types)
     {
         auto format = R"(    struct %
@@ -2688,12 +2855,14 @@ struct XLANG_EBO produce_dispatch_to_overridable<T, D, %>
         if (namespace_name == "Foundation.Collections")
         {
             w.write(strings::base_collections);
+            w.write(strings::base_collections_flat_map);
             w.write(strings::base_collections_base);
             w.write(strings::base_collections_input_iterable);
             w.write(strings::base_collections_input_vector_view);
             w.write(strings::base_collections_input_map_view);
             w.write(strings::base_collections_input_vector);
             w.write(strings::base_collections_input_map);
+            w.write(strings::base_collections_multi_threaded);
             w.write(strings::base_collections_vector);
             w.write(strings::base_collections_map);
         }
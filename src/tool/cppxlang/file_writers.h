@@ -47,14 +47,29 @@ namespace xlang
 
         w.write(R"(
 #include <experimental/coroutine>
+#include "xlang/base.h"
+)");
+
+        w.write(strings::base_coroutine_frame);
+        w.write(strings::base_coroutine_threadpool);
+        w.write(strings::base_coroutine_await);
+        w.write(strings::base_coroutine_fire_and_forget);
+        w.write(strings::base_coroutine_cancel);
+
+        // The async interfaces are only available when the Foundation namespace has been projected.
+        w.write(R"(
+#if __has_include("xlang/Foundation.h")
 #include "xlang/Foundation.h"
 )");
 
-        w.write(strings::base_coroutine);
         w.write(strings::base_coroutine_resume);
+        w.write(strings::base_coroutine);
         w.write(strings::base_coroutine_action);
         w.write(strings::base_coroutine_operation);
-        w.write(strings::base_coroutine_fire_and_forget);
+
+        w.write(R"(
+#endif
+)");
 
         write_close_file_guard(w);
         w.flush_to_file(settings.output_folder + "xlang/coroutine.h");
@@ -91,6 +106,7 @@ namespace xlang
         w.write_each<write_delegate_abi>(members.delegates);
         w.write_each<write_consume>(members.interfaces);
         w.write_each<write_struct_abi>(members.structs);
+        w.write_each<write_bulk_properties_abi>(members.interfaces);
         write_close_namespace(w);
 
         write_close_file_guard(w);
@@ -138,10 +154,18 @@ namespace xlang
 
         write_type_namespace(w, ns);
         w.write_each<write_delegate>(members.delegates);
-        bool const promote = write_structs(w, members.structs);
+        bool promote = write_structs(w, members.structs);
         w.write_each<write_class>(members.classes);
         w.write_each<write_interface_override>(members.classes);
         write_close_namespace(w);
+
+        if (std::any_of(members.interfaces.begin(), members.interfaces.end(), has_bulk_properties))
+        {
+            write_xlang_namespace(w);
+            promote = write_bulk_properties(w, members.interfaces) || promote;
+            write_close_namespace(w);
+        }
+
         write_namespace_special(w, ns, c);
 
         write_close_file_guard(w);
@@ -188,6 +188,77 @@ namespace xlang
         return async;
     }
 
+    // Interfaces marked with Foundation.Metadata.BulkPropertiesAttribute, and the default interfaces of classes marked
+    // with it, have a companion bulk properties interface that returns all of their readable properties in a single
+    // call. They are collected once by get_bulk_properties_interfaces.
+    static bool has_bulk_properties(TypeDef const& type)
+    {
+        return settings.bulk_properties.find(type) != settings.bulk_properties.end();
+    }
+
+    static std::set<TypeDef> get_bulk_properties_interfaces(cache const& c)
+    {
+        std::set<TypeDef> result;
+
+        auto add = [&](TypeDef const& type)
+        {
+            if (empty(type.GenericParam()))
+            {
+                result.insert(type);
+            }
+        };
+
+        for (auto&&[ns, members] : c.namespaces())
+        {
+            for (auto&& type : members.interfaces)
+            {
+                if (has_attribute(type, "Foundation.Metadata", "BulkPropertiesAttribute"))
+                {
+                    add(type);
+                }
+            }
+
+            for (auto&& type : members.classes)
+            {
+                if (!has_attribute(type, "Foundation.Metadata", "BulkPropertiesAttribute"))
+                {
+                    continue;
+                }
+
+                auto default_interface = get_default_interface(type);
+
+                if (default_interface && default_interface.type() != TypeDefOrRef::TypeSpec)
+                {
+                    add(find_required(default_interface));
+                }
+            }
+        }
+
+        return result;
+    }
+
+    static auto get_bulk_properties(TypeDef const& type)
+    {
+        std::vector<MethodDef> getters;
+
+        for (auto&& method : type.MethodList())
+        {
+            if (!method.SpecialName() || !starts_with(method.Name(), "get_"))
+            {
+                continue;
+            }
+
+            method_signature signature{ method };
+
+            if (signature.params().empty() && signature.return_signature() && !signature.return_signature().Type().is_szarray())
+            {
+                getters.push_back(method);
+            }
+        }
+
+        return getters;
+    }
+
     static TypeDef get_base_class(TypeDef const& derived)
     {
         auto extends = derived.Extends();
@@ -223,6 +223,7 @@ Where <spec> is one or more of:
             cache c{ get_files_to_cache() };
             remove_foundation_types(c);
             build_filters(c);
+            settings.bulk_properties = get_bulk_properties_interfaces(c);
             settings.base = settings.base || (!settings.component && settings.projection_filter.empty());
 
             if (settings.verbose)
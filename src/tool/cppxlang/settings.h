@@ -28,6 +28,8 @@ namespace xlang
 
         meta::reader::filter projection_filter;
         meta::reader::filter component_filter;
+
+        std::set<meta::reader::TypeDef> bulk_properties;
     };
 
     extern settings_type settings;
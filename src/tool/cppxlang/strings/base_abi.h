@@ -163,4 +163,14 @@ namespace xlang::impl
     {
         static constexpr guid value{ 0x905a0fef,0xbc53,0x11df,{ 0x8c,0x49,0x00,0x1e,0x4f,0xc6,0x86,0xda } };
     };
+
+    struct XLANG_NOVTABLE IVectorBufferAccess : unknown_abi
+    {
+        virtual int32_t XLANG_CALL GetBuffer(uint32_t element_size, void const** data, uint32_t* size, uint32_t* version) noexcept = 0;
+        virtual uint32_t XLANG_CALL GetVersion() noexcept = 0;
+    };
+    template <> struct guid_storage<IVectorBufferAccess>
+    {
+        static constexpr guid value{ 0x6c1f3e52,0x8d0a,0x4b7e,{ 0xa4,0x19,0x3f,0x62,0xd5,0x0e,0x91,0xc7 } };
+    };
 }
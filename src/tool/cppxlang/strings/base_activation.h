@@ -14,6 +14,24 @@ namespace xlang
 
 namespace xlang::impl
 {
+    // Counting is opt-in, so that a cache hit remains a single atomic load unless statistics are enabled.
+    struct factory_cache_counters
+    {
+        std::atomic<bool> enabled{};
+        std::atomic<uint64_t> hits{};
+        std::atomic<uint64_t> misses{};
+
+        void record(std::atomic<uint64_t>& counter) noexcept
+        {
+            if (enabled.load(std::memory_order_relaxed))
+            {
+                counter.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    inline factory_cache_counters factory_cache_statistics;
+
     template <typename Class, typename Interface>
     struct factory_cache_entry
     {
@@ -23,9 +41,11 @@ namespace xlang::impl
             void* value = m_value.load(std::memory_order_acquire);
             if (value)
             {
+                factory_cache_statistics.record(factory_cache_statistics.hits);
                 return callback(*reinterpret_cast<com_ref<Interface> const*>(&value));
             }
 
+            factory_cache_statistics.record(factory_cache_statistics.misses);
             auto object = get_activation_factory<Interface>(name_of<Class>());
             if (m_value.compare_exchange_strong(value, get_abi(object), std::memory_order_acq_rel))
             {
@@ -60,6 +80,14 @@ namespace xlang::impl
     {
         param::hstring const name{ name_of<Class>() };
         void* result;
+
+        if (!exception)
+        {
+            // The caller has no use for the error, so don't originate one.
+            xlang_try_get_activation_factory(get_abi(name), guid_of<Interface>(), &result);
+            return { result, take_ownership_from_abi };
+        }
+
         auto const hr = xlang_get_activation_factory(get_abi(name), guid_of<Interface>(), &result);
 
         if (hr != nullptr)
@@ -77,6 +105,56 @@ namespace xlang::impl
         return { result, take_ownership_from_abi };
     }
 
+    // Calls the function with each index below count, spread across up to one thread per core. The first
+    // exception thrown is rethrown once every call has finished.
+    template <typename F>
+    void parallel_for_each_index(uint32_t const count, F const& function)
+    {
+        std::atomic<uint32_t> next{};
+        std::exception_ptr error;
+        std::mutex lock;
+
+        auto worker = [&]
+        {
+            for (uint32_t index = next++; index < count; index = next++)
+            {
+                try
+                {
+                    function(index);
+                }
+                catch (...)
+                {
+                    std::lock_guard const guard(lock);
+
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+        };
+
+        uint32_t const thread_count = (std::min)(count, (std::max)(1u, std::thread::hardware_concurrency()));
+        std::vector<std::thread> threads;
+
+        for (uint32_t index = 1; index < thread_count; ++index)
+        {
+            threads.emplace_back(worker);
+        }
+
+        worker();
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+
     template <> struct abi<Windows::Foundation::IActivationFactory>
     {
         struct XLANG_NOVTABLE type : xlang_object_abi
@@ -117,6 +195,65 @@ namespace xlang
         });
     }
 
+    // Resolves the activation factories of the classes in parallel and caches them, so that the first activation
+    // of each class doesn't load modules on demand. Throws the first error encountered.
+    template <typename... Classes>
+    void preload_activation_factories()
+    {
+        if constexpr (sizeof...(Classes) != 0)
+        {
+            static constexpr void(*preload[])() =
+            {
+                []
+                {
+                    impl::call_factory<Classes>([](auto&&) {});
+                }...
+            };
+
+            impl::parallel_for_each_index(static_cast<uint32_t>(std::size(preload)), [](uint32_t index)
+            {
+                preload[index]();
+            });
+        }
+    }
+
+    // Resolves activation factories by class name in parallel. This doesn't fill the per-class caches, but loads
+    // the modules implementing the classes and warms the PAL's own caches, so any factory interface will do.
+    inline void preload_activation_factories(array_view<hstring const> class_names)
+    {
+        impl::parallel_for_each_index(class_names.size(), [&](uint32_t index)
+        {
+            get_activation_factory<Windows::Foundation::IUnknown>(class_names[index]);
+        });
+    }
+
+    struct factory_cache_statistics
+    {
+        uint64_t hits;
+        uint64_t misses;
+    };
+
+    // Counts the calls made through the factory caches of the calling module.
+    inline void enable_factory_cache_statistics(bool enable) noexcept
+    {
+        impl::factory_cache_statistics.enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    inline factory_cache_statistics get_factory_cache_statistics() noexcept
+    {
+        return
+        {
+            impl::factory_cache_statistics.hits.load(std::memory_order_relaxed),
+            impl::factory_cache_statistics.misses.load(std::memory_order_relaxed)
+        };
+    }
+
+    inline void reset_factory_cache_statistics() noexcept
+    {
+        impl::factory_cache_statistics.hits.store(0, std::memory_order_relaxed);
+        impl::factory_cache_statistics.misses.store(0, std::memory_order_relaxed);
+    }
+
     template <typename Class, typename Interface = Windows::Foundation::IActivationFactory>
     auto try_get_activation_factory() noexcept
     {
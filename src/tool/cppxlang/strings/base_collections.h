@@ -3,29 +3,62 @@ namespace xlang::impl
 {
     namespace fc = Foundation::Collections;
 
+    // Elements are read in chunks of 256 bytes, with a minimum of 4 elements.
+    template <typename T>
+    inline constexpr uint32_t fast_iterator_chunk_size = static_cast<uint32_t>((std::max)(size_t{ 4 }, 256 / sizeof(T)));
+
+    template <typename T, typename Value, typename = void>
+    struct has_GetMany : std::false_type {};
+
+    template <typename T, typename Value>
+    struct has_GetMany<T, Value, std::void_t<decltype(std::declval<T const&>().GetMany(0, std::declval<array_view<Value>>()))>> : std::true_type {};
+
+    // Reads the elements of a vector through GetMany a chunk at a time, rather than calling GetAt for each element.
+    // The chunk is held inline and isn't copied along with the iterator; a copy reads its own chunk when first
+    // dereferenced, so end() and copies stay cheap. The reference returned by operator* remains valid until the
+    // iterator is incremented.
     template <typename T>
     struct fast_iterator
     {
         using iterator_category = std::input_iterator_tag;
-        using value_type = T;
+        using value_type = std::decay_t<decltype(std::declval<T const&>().GetAt(0))>;
         using difference_type = ptrdiff_t;
-        using pointer = T * ;
-        using reference = T & ;
+        using pointer = value_type const*;
+        using reference = value_type const&;
 
         fast_iterator(T const& collection, uint32_t const index) noexcept :
         m_collection(&collection),
             m_index(index)
         {}
 
+        fast_iterator(fast_iterator const& other) noexcept :
+            m_collection(other.m_collection),
+            m_index(other.m_index)
+        {}
+
+        fast_iterator& operator=(fast_iterator const& other) noexcept
+        {
+            m_collection = other.m_collection;
+            m_index = other.m_index;
+            m_count = 0;
+            return *this;
+        }
+
         fast_iterator& operator++() noexcept
         {
             ++m_index;
             return*this;
         }
 
-        auto operator*() const
+        value_type const& operator*() const
         {
-            return m_collection->GetAt(m_index);
+            // Also refills when the index is before the chunk, as the subtraction then wraps around.
+            if (m_index - m_first >= m_count)
+            {
+                fill();
+            }
+
+            return m_buffer[m_index - m_first];
         }
 
         bool operator==(fast_iterator const& other) const noexcept
@@ -41,8 +74,110 @@ namespace xlang::impl
 
     private:
 
+        void fill() const
+        {
+            m_first = m_index;
+            m_count = 0;
+
+            if constexpr (has_GetMany<T, value_type>::value)
+            {
+                m_count = m_collection->GetMany(m_index, { m_buffer.data(), m_buffer.data() + m_buffer.size() });
+            }
+
+            // GetAt reports an index that is out of bounds.
+            if (m_count == 0)
+            {
+                m_buffer[0] = m_collection->GetAt(m_index);
+                m_count = 1;
+            }
+        }
+
         T const* m_collection = nullptr;
         uint32_t m_index = 0;
+        mutable uint32_t m_first = 0;
+        mutable uint32_t m_count = 0;
+        mutable std::array<value_type, has_GetMany<T, value_type>::value ? fast_iterator_chunk_size<value_type> : 1> m_buffer;
+    };
+
+    // Walks an iterable through the IIterator returned by First, pulling its elements a chunk at a time through
+    // IIterator::GetMany rather than calling Current and MoveNext for each element. As with the IIterator itself,
+    // copies advance the same underlying iterator. The first chunk is only read when the iterator is first
+    // dereferenced or incremented, so until then it converts back to the IIterator it wraps. The reference
+    // returned by operator* remains valid until the iterator is incremented.
+    template <typename T>
+    struct fast_iterable_iterator
+    {
+        using iterator_type = decltype(std::declval<T const&>().First());
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::decay_t<decltype(std::declval<iterator_type const&>().Current())>;
+        using difference_type = ptrdiff_t;
+        using pointer = value_type const*;
+        using reference = value_type const&;
+
+        fast_iterable_iterator() noexcept = default;
+
+        explicit fast_iterable_iterator(iterator_type&& iterator) noexcept :
+            m_iterator(std::move(iterator))
+        {}
+
+        operator iterator_type() const noexcept
+        {
+            XLANG_ASSERT(m_position == m_count);
+            return m_iterator;
+        }
+
+        fast_iterable_iterator& operator++()
+        {
+            if (m_position == m_count)
+            {
+                fill();
+            }
+
+            if (++m_position == m_count)
+            {
+                fill();
+            }
+
+            return *this;
+        }
+
+        value_type const& operator*() const
+        {
+            if (m_position == m_count)
+            {
+                fill();
+            }
+
+            return m_buffer[m_position];
+        }
+
+        bool operator==(fast_iterable_iterator const& other) const noexcept
+        {
+            return m_iterator == other.m_iterator && m_position == other.m_position && m_count == other.m_count;
+        }
+
+        bool operator!=(fast_iterable_iterator const& other) const noexcept
+        {
+            return !(*this == other);
+        }
+
+    private:
+
+        void fill() const
+        {
+            m_position = 0;
+            m_count = m_iterator.GetMany({ m_buffer.data(), m_buffer.data() + m_buffer.size() });
+
+            if (m_count == 0)
+            {
+                m_iterator = nullptr;
+            }
+        }
+
+        mutable iterator_type m_iterator{ nullptr };
+        mutable uint32_t m_position = 0;
+        mutable uint32_t m_count = 0;
+        mutable std::array<value_type, fast_iterator_chunk_size<value_type>> m_buffer;
     };
 
     template <typename T>
@@ -56,8 +191,8 @@ namespace xlang::impl
         static constexpr bool value = get_value<T>(0);
     };
 
-    template <typename T, std::enable_if_t<!has_GetAt<T>::value>* = nullptr>
-    auto begin(T const& collection) -> decltype(collection.First())
+    template <typename T, std::enable_if_t<!has_GetAt<T>::value>* = nullptr, typename = decltype(std::declval<T const&>().First())>
+    fast_iterable_iterator<T> begin(T const& collection)
     {
         auto result = collection.First();
 
@@ -66,11 +201,11 @@ namespace xlang::impl
             return {};
         }
 
-        return result;
+        return fast_iterable_iterator<T>(std::move(result));
     }
 
-    template <typename T, std::enable_if_t<!has_GetAt<T>::value>* = nullptr>
-    auto end([[maybe_unused]] T const& collection) noexcept -> decltype(collection.First())
+    template <typename T, std::enable_if_t<!has_GetAt<T>::value>* = nullptr, typename = decltype(std::declval<T const&>().First())>
+    fast_iterable_iterator<T> end([[maybe_unused]] T const& collection) noexcept
     {
         return {};
     }
@@ -0,0 +1,281 @@
+
+namespace xlang::impl
+{
+    // An open addressing hash map. The entries are stored contiguously, in insertion order until one is removed,
+    // and are indexed by a power of two sized table of slots. Each slot holds an entry's index and the upper bits
+    // of its hash, so that most probes compare the slot alone. Removing an entry moves the last entry into its
+    // place, and the probe sequence is closed up behind it rather than leaving a tombstone.
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K, V>>>
+    struct flat_hash_map
+    {
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Allocator;
+        using const_iterator = typename std::vector<value_type, Allocator>::const_iterator;
+        using iterator = const_iterator;
+
+        flat_hash_map() = default;
+
+        template <typename InputIt>
+        flat_hash_map(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+            {
+                try_emplace(first->first, first->second);
+            }
+        }
+
+        flat_hash_map(std::initializer_list<std::pair<K const, V>> values) : flat_hash_map(values.begin(), values.end())
+        {
+        }
+
+        const_iterator begin() const noexcept
+        {
+            return m_entries.begin();
+        }
+
+        const_iterator end() const noexcept
+        {
+            return m_entries.end();
+        }
+
+        size_type size() const noexcept
+        {
+            return m_entries.size();
+        }
+
+        bool empty() const noexcept
+        {
+            return m_entries.empty();
+        }
+
+        const_iterator find(K const& key) const
+        {
+            uint32_t const slot = find_slot(key, hash_key(key));
+            return slot == npos ? end() : begin() + (m_slots[slot].index - 1);
+        }
+
+        size_type count(K const& key) const
+        {
+            return find_slot(key, hash_key(key)) != npos;
+        }
+
+        template <typename Value>
+        std::pair<const_iterator, bool> insert_or_assign(K const& key, Value&& value)
+        {
+            uint32_t const hash = hash_key(key);
+            uint32_t const slot = find_slot(key, hash);
+
+            if (slot != npos)
+            {
+                uint32_t const index = m_slots[slot].index - 1;
+                m_entries[index].second = std::forward<Value>(value);
+                return { begin() + index, false };
+            }
+
+            return { add(hash, key, std::forward<Value>(value)), true };
+        }
+
+        template <typename... Args>
+        std::pair<const_iterator, bool> try_emplace(K const& key, Args&&... args)
+        {
+            uint32_t const hash = hash_key(key);
+            uint32_t const slot = find_slot(key, hash);
+
+            if (slot != npos)
+            {
+                return { begin() + (m_slots[slot].index - 1), false };
+            }
+
+            return { add(hash, key, std::forward<Args>(args)...), true };
+        }
+
+        size_type erase(K const& key)
+        {
+            uint32_t const slot = find_slot(key, hash_key(key));
+
+            if (slot == npos)
+            {
+                return 0;
+            }
+
+            uint32_t const index = m_slots[slot].index - 1;
+            uint32_t const last = static_cast<uint32_t>(m_entries.size() - 1);
+            close_slot(slot);
+
+            if (index != last)
+            {
+                uint32_t moved = home(hash_key(m_entries[last].first));
+
+                while (m_slots[moved].index != last + 1)
+                {
+                    moved = (moved + 1) & mask();
+                }
+
+                m_entries[index] = std::move(m_entries[last]);
+                m_slots[moved].index = index + 1;
+            }
+
+            m_entries.pop_back();
+            return 1;
+        }
+
+        void clear() noexcept
+        {
+            m_entries.clear();
+            std::fill(m_slots.begin(), m_slots.end(), slot_type{});
+        }
+
+        void reserve(size_type const count)
+        {
+            m_entries.reserve(count);
+
+            if (count > capacity())
+            {
+                rehash(count);
+            }
+        }
+
+    private:
+
+        struct slot_type
+        {
+            uint32_t index;
+            uint32_t hash;
+        };
+
+        static constexpr uint32_t npos = 0xffffffff;
+
+        // Fibonacci hashing spreads out hashes that differ only in their low bits, such as those of integers.
+        uint32_t hash_key(K const& key) const
+        {
+            return static_cast<uint32_t>((static_cast<uint64_t>(m_hash(key)) * 0x9e3779b97f4a7c15ULL) >> 32);
+        }
+
+        uint32_t mask() const noexcept
+        {
+            return static_cast<uint32_t>(m_slots.size() - 1);
+        }
+
+        uint32_t home(uint32_t const hash) const noexcept
+        {
+            return hash >> m_shift;
+        }
+
+        // The table is kept at most three quarters full.
+        size_type capacity() const noexcept
+        {
+            return m_slots.size() / 4 * 3;
+        }
+
+        uint32_t find_slot(K const& key, uint32_t const hash) const
+        {
+            if (m_slots.empty())
+            {
+                return npos;
+            }
+
+            for (uint32_t slot = home(hash);; slot = (slot + 1) & mask())
+            {
+                slot_type const& value = m_slots[slot];
+
+                if (!value.index)
+                {
+                    return npos;
+                }
+
+                if (value.hash == hash && m_equal(m_entries[value.index - 1].first, key))
+                {
+                    return slot;
+                }
+            }
+        }
+
+        template <typename... Args>
+        const_iterator add(uint32_t const hash, K const& key, Args&&... args)
+        {
+            if (m_entries.size() + 1 > capacity())
+            {
+                rehash(m_entries.size() + 1);
+            }
+
+            m_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+            insert_slot({ static_cast<uint32_t>(m_entries.size()), hash });
+            return end() - 1;
+        }
+
+        void insert_slot(slot_type const value) noexcept
+        {
+            uint32_t slot = home(value.hash);
+
+            while (m_slots[slot].index)
+            {
+                slot = (slot + 1) & mask();
+            }
+
+            m_slots[slot] = value;
+        }
+
+        // Shifts back any entries that probed past the slot being emptied, so lookups still find them.
+        void close_slot(uint32_t hole) noexcept
+        {
+            for (uint32_t next = (hole + 1) & mask(); m_slots[next].index; next = (next + 1) & mask())
+            {
+                uint32_t const distance = (next - home(m_slots[next].hash)) & mask();
+
+                if (distance >= ((next - hole) & mask()))
+                {
+                    m_slots[hole] = m_slots[next];
+                    hole = next;
+                }
+            }
+
+            m_slots[hole] = {};
+        }
+
+        void rehash(size_type const count)
+        {
+            uint32_t bits = 3;
+
+            while ((size_t{ 1 } << bits) / 4 * 3 < count)
+            {
+                ++bits;
+            }
+
+            std::vector<slot_type, slot_allocator> slots(size_t{ 1 } << bits);
+            std::swap(m_slots, slots);
+            m_shift = 32 - bits;
+
+            for (slot_type const& value : slots)
+            {
+                if (value.index)
+                {
+                    insert_slot(value);
+                }
+            }
+        }
+
+        using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot_type>;
+
+        std::vector<value_type, Allocator> m_entries;
+        std::vector<slot_type, slot_allocator> m_slots;
+        uint32_t m_shift{ 32 };
+        Hash m_hash;
+        KeyEqual m_equal;
+    };
+
+    template <typename K, typename = void>
+    struct is_hashable : std::false_type {};
+
+    template <typename K>
+    struct is_hashable<K, std::void_t<decltype(std::hash<K>{}(std::declval<K const&>()))>> : std::true_type {};
+
+    // The container used when no ordering is asked for: a flat hash map if the key can be hashed.
+    template <typename K, typename V>
+    using default_map = std::conditional_t<is_hashable<K>::value, flat_hash_map<K, V>, std::map<K, V>>;
+}
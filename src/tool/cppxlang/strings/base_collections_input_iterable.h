@@ -320,7 +320,7 @@ namespace xlang::param
         }
 
         async_iterable(std::initializer_list<std::pair<K const, V>> values) :
-            m_interface(impl::make_input_iterable<value_type>(std::map<K, V>(values)))
+            m_interface(impl::make_input_iterable<value_type>(impl::default_map<K, V>(values.begin(), values.end())))
         {
         }
 
@@ -73,7 +73,7 @@ namespace xlang::param
         }
 
         map(std::initializer_list<std::pair<K const, V>> values) :
-            m_interface(impl::make_input_map<K, V>(std::map<K, V>(values)))
+            m_interface(impl::make_input_map<K, V>(impl::default_map<K, V>(values.begin(), values.end())))
         {
         }
 
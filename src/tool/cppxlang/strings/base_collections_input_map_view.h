@@ -117,7 +117,7 @@ namespace xlang::param
         {
         }
 
-        map_view(std::initializer_list<std::pair<K const, V>> values) : m_pair(impl::make_input_map_view<K, V>(std::map<K, V>(values)), nullptr)
+        map_view(std::initializer_list<std::pair<K const, V>> values) : m_pair(impl::make_input_map_view<K, V>(impl::default_map<K, V>(values.begin(), values.end())), nullptr)
         {
         }
 
@@ -188,7 +188,7 @@ namespace xlang::param
         }
 
         async_map_view(std::initializer_list<std::pair<K const, V>> values) :
-            m_interface(impl::make_input_map_view<K, V>(std::map<K, V>(values)))
+            m_interface(impl::make_input_map_view<K, V>(impl::default_map<K, V>(values.begin(), values.end())))
         {
         }
 
@@ -1,6 +1,69 @@
 
 namespace xlang::impl
 {
+    template <typename T, typename Container, typename = void>
+    struct is_buffer_accessible : std::false_type {};
+
+    template <typename T, typename Container>
+    struct is_buffer_accessible<T, Container, std::void_t<decltype(std::declval<Container const&>().data())>> : std::conjunction<
+        std::is_trivially_copyable<T>,
+        std::is_same<T const*, decltype(std::declval<Container const&>().data())>> {};
+
+    // A tearoff exposing the contiguous storage of a vector to consumers in the same process.
+    template <typename D>
+    struct vector_buffer_access final : IVectorBufferAccess
+    {
+        explicit vector_buffer_access(D* owner) noexcept : m_owner(owner)
+        {
+        }
+
+        int32_t XLANG_CALL QueryInterface(guid const& id, void** object) noexcept final
+        {
+            return m_owner->QueryInterface(id, object);
+        }
+
+        uint32_t XLANG_CALL AddRef() noexcept final
+        {
+            return m_owner->AddRef();
+        }
+
+        uint32_t XLANG_CALL Release() noexcept final
+        {
+            return m_owner->Release();
+        }
+
+        int32_t XLANG_CALL GetBuffer(uint32_t const element_size, void const** data, uint32_t* size, uint32_t* version) noexcept final
+        {
+            auto const& container = m_owner->get_container();
+
+            if (element_size != sizeof(*container.data()))
+            {
+                return error_invalid_argument;
+            }
+
+            *version = m_owner->get_version();
+            *data = container.data();
+            *size = static_cast<uint32_t>(container.size());
+            return error_ok;
+        }
+
+        uint32_t XLANG_CALL GetVersion() noexcept final
+        {
+            return m_owner->get_version();
+        }
+
+    private:
+
+        D* const m_owner;
+    };
+
+    struct no_buffer_access
+    {
+        explicit no_buffer_access(void*) noexcept
+        {
+        }
+    };
+
     template <typename T, typename Container>
     struct input_vector :
         implements<input_vector<T, Container>, fc::IVector<T>, fc::IVectorView<T>, fc::IIterable<T>>,
@@ -22,9 +85,25 @@ namespace xlang::impl
             return m_values;
         }
 
+        int32_t query_interface_tearoff(guid const& id, void** object) noexcept
+        {
+            if constexpr (is_buffer_accessible<T, Container>::value)
+            {
+                if (is_guid_of<IVectorBufferAccess>(id))
+                {
+                    *object = static_cast<IVectorBufferAccess*>(&m_buffer_access);
+                    this->AddRef();
+                    return error_ok;
+                }
+            }
+
+            return error_no_interface;
+        }
+
     private:
 
         Container m_values;
+        std::conditional_t<is_buffer_accessible<T, Container>::value, vector_buffer_access<input_vector>, no_buffer_access> m_buffer_access{ this };
     };
 }
 
@@ -1,7 +1,15 @@
 
 namespace xlang
 {
-    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    // Unless a Compare is given, keys that can be hashed are kept in a flat hash map and iterate in no particular
+    // order.
+    template <typename K, typename V>
+    Foundation::Collections::IMap<K, V> single_threaded_map()
+    {
+        return make<impl::input_map<K, V, impl::default_map<K, V>>>(impl::default_map<K, V>{});
+    }
+
+    template <typename K, typename V, typename Compare, typename Allocator = std::allocator<std::pair<K const, V>>>
     Foundation::Collections::IMap<K, V> single_threaded_map()
     {
         return make<impl::input_map<K, V, std::map<K, V, Compare, Allocator>>>(std::map<K, V, Compare, Allocator>{});
@@ -18,4 +26,30 @@ namespace xlang
     {
         return make<impl::input_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
     }
+
+    // A map that may be used from several threads at once. Iterators see a snapshot of the map taken when they
+    // were created, so iterating never blocks writers and isn't invalidated by them.
+    template <typename K, typename V>
+    Foundation::Collections::IMap<K, V> multi_threaded_map()
+    {
+        return make<impl::multi_threaded_map<K, V, impl::default_map<K, V>>>(impl::default_map<K, V>{});
+    }
+
+    template <typename K, typename V, typename Compare, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Foundation::Collections::IMap<K, V> multi_threaded_map()
+    {
+        return make<impl::multi_threaded_map<K, V, std::map<K, V, Compare, Allocator>>>(std::map<K, V, Compare, Allocator>{});
+    }
+
+    template <typename K, typename V, typename Compare = std::less<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Foundation::Collections::IMap<K, V> multi_threaded_map(std::map<K, V, Compare, Allocator>&& values)
+    {
+        return make<impl::multi_threaded_map<K, V, std::map<K, V, Compare, Allocator>>>(std::move(values));
+    }
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>, typename Allocator = std::allocator<std::pair<K const, V>>>
+    Foundation::Collections::IMap<K, V> multi_threaded_map(std::unordered_map<K, V, Hash, KeyEqual, Allocator>&& values)
+    {
+        return make<impl::multi_threaded_map<K, V, std::unordered_map<K, V, Hash, KeyEqual, Allocator>>>(std::move(values));
+    }
 }
@@ -0,0 +1,291 @@
+
+namespace xlang::impl
+{
+    // Guards a container shared between threads. Reads take a shared lock. Writes take an exclusive lock and first
+    // copy the container if an iterator still holds a snapshot of it, so that iterators never take the lock.
+    template <typename Container>
+    struct shared_container
+    {
+        explicit shared_container(Container&& values) :
+            m_values(std::make_shared<Container>(std::move(values)))
+        {
+        }
+
+        std::shared_lock<std::shared_mutex> lock_shared() const
+        {
+            return std::shared_lock<std::shared_mutex>(m_lock);
+        }
+
+        std::unique_lock<std::shared_mutex> lock_exclusive()
+        {
+            std::unique_lock<std::shared_mutex> guard(m_lock);
+
+            // Snapshots are only taken under the lock, so the count can't grow while it is held. An iterator may
+            // still be releasing its snapshot, in which case the container is copied needlessly.
+            if (m_values.use_count() != 1)
+            {
+                m_values = std::make_shared<Container>(std::as_const(*m_values));
+            }
+
+            // Pairs with the release of the last snapshot, which may have happened on another thread.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return guard;
+        }
+
+        std::shared_ptr<Container const> snapshot() const
+        {
+            std::shared_lock const guard(m_lock);
+            return m_values;
+        }
+
+        Container& get() noexcept
+        {
+            return *m_values;
+        }
+
+        Container const& get() const noexcept
+        {
+            return *m_values;
+        }
+
+    private:
+
+        mutable std::shared_mutex m_lock;
+        std::shared_ptr<Container> m_values;
+    };
+
+    // Iterates over a snapshot of the container taken when the iterator was created. Changes made to the collection
+    // afterwards aren't seen and, unlike the iterators of single threaded collections, don't invalidate it.
+    template <typename T, typename Container>
+    struct snapshot_iterator : implements<snapshot_iterator<T, Container>, fc::IIterator<T>>
+    {
+        explicit snapshot_iterator(std::shared_ptr<Container const>&& snapshot) noexcept :
+            m_snapshot(std::move(snapshot)),
+            m_current(m_snapshot->begin()),
+            m_end(m_snapshot->end())
+        {
+        }
+
+        T Current() const
+        {
+            if (m_current == m_end)
+            {
+                throw hresult_out_of_bounds();
+            }
+
+            return make_value(*m_current);
+        }
+
+        bool HasCurrent() const noexcept
+        {
+            return m_current != m_end;
+        }
+
+        bool MoveNext() noexcept
+        {
+            if (m_current != m_end)
+            {
+                ++m_current;
+            }
+
+            return HasCurrent();
+        }
+
+        uint32_t GetMany(array_view<T> values)
+        {
+            uint32_t const actual = (std::min)(static_cast<uint32_t>(std::distance(m_current, m_end)), values.size());
+            auto const last = std::next(m_current, actual);
+            std::transform(m_current, last, values.begin(), [](auto&& value) { return make_value(value); });
+            m_current = last;
+            return actual;
+        }
+
+    private:
+
+        template <typename U>
+        static T make_value(U const& value)
+        {
+            if constexpr (is_key_value_pair<T>::value)
+            {
+                return make<key_value_pair<T>>(value.first, value.second);
+            }
+            else
+            {
+                return value;
+            }
+        }
+
+        std::shared_ptr<Container const> const m_snapshot;
+        typename Container::const_iterator m_current;
+        typename Container::const_iterator const m_end;
+    };
+
+    template <typename T, typename Container>
+    struct multi_threaded_vector :
+        implements<multi_threaded_vector<T, Container>, fc::IVector<T>, fc::IVectorView<T>, fc::IIterable<T>>,
+        vector_base<multi_threaded_vector<T, Container>, T>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+        static_assert(std::is_same_v<T, typename Container::value_type>, "Elements must be stored as they are projected.");
+
+        using base_type = vector_base<multi_threaded_vector<T, Container>, T>;
+
+        explicit multi_threaded_vector(Container&& values) : m_values(std::forward<Container>(values))
+        {
+        }
+
+        auto& get_container() noexcept
+        {
+            return m_values.get();
+        }
+
+        auto& get_container() const noexcept
+        {
+            return m_values.get();
+        }
+
+        auto First()
+        {
+            return make<snapshot_iterator<T, Container>>(m_values.snapshot());
+        }
+
+        T GetAt(uint32_t const index) const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::GetAt(index);
+        }
+
+        uint32_t Size() const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::Size();
+        }
+
+        bool IndexOf(T const& value, uint32_t& index) const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::IndexOf(value, index);
+        }
+
+        uint32_t GetMany(uint32_t const startIndex, array_view<T> values) const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::GetMany(startIndex, values);
+        }
+
+        void SetAt(uint32_t const index, T const& value)
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::SetAt(index, value);
+        }
+
+        void InsertAt(uint32_t const index, T const& value)
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::InsertAt(index, value);
+        }
+
+        void RemoveAt(uint32_t const index)
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::RemoveAt(index);
+        }
+
+        void Append(T const& value)
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::Append(value);
+        }
+
+        void RemoveAtEnd()
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::RemoveAtEnd();
+        }
+
+        void Clear()
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::Clear();
+        }
+
+        void ReplaceAll(array_view<T const> value)
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::ReplaceAll(value);
+        }
+
+    private:
+
+        shared_container<Container> m_values;
+    };
+
+    template <typename K, typename V, typename Container>
+    struct multi_threaded_map :
+        implements<multi_threaded_map<K, V, Container>, fc::IMap<K, V>, fc::IMapView<K, V>, fc::IIterable<fc::IKeyValuePair<K, V>>>,
+        map_base<multi_threaded_map<K, V, Container>, K, V>
+    {
+        static_assert(std::is_same_v<Container, std::remove_reference_t<Container>>, "Must be constructed with rvalue.");
+
+        using base_type = map_base<multi_threaded_map<K, V, Container>, K, V>;
+
+        explicit multi_threaded_map(Container&& values) : m_values(std::forward<Container>(values))
+        {
+        }
+
+        auto& get_container() noexcept
+        {
+            return m_values.get();
+        }
+
+        auto& get_container() const noexcept
+        {
+            return m_values.get();
+        }
+
+        auto First()
+        {
+            return make<snapshot_iterator<fc::IKeyValuePair<K, V>, Container>>(m_values.snapshot());
+        }
+
+        V Lookup(K const& key) const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::Lookup(key);
+        }
+
+        uint32_t Size() const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::Size();
+        }
+
+        bool HasKey(K const& key) const
+        {
+            auto const guard = m_values.lock_shared();
+            return base_type::HasKey(key);
+        }
+
+        bool Insert(K const& key, V const& value)
+        {
+            auto const guard = m_values.lock_exclusive();
+            return base_type::Insert(key, value);
+        }
+
+        void Remove(K const& key)
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::Remove(key);
+        }
+
+        void Clear()
+        {
+            auto const guard = m_values.lock_exclusive();
+            base_type::Clear();
+        }
+
+    private:
+
+        shared_container<Container> m_values;
+    };
+}
@@ -6,4 +6,109 @@ namespace xlang
     {
         return make<impl::input_vector<T, std::vector<T, Allocator>>>(std::move(values));
     }
+
+    // A vector that may be used from several threads at once. Iterators see a snapshot of the vector taken when
+    // they were created, so iterating never blocks writers and isn't invalidated by them.
+    template <typename T, typename Allocator = std::allocator<T>>
+    Foundation::Collections::IVector<T> multi_threaded_vector(std::vector<T, Allocator>&& values = {})
+    {
+        return make<impl::multi_threaded_vector<T, std::vector<T, Allocator>>>(std::move(values));
+    }
+}
+
+namespace xlang
+{
+    // The storage behind a vector of trivially copyable elements, for reading it in place when the vector was
+    // created in the same process. The storage is only valid until the vector is next modified. Reading it while
+    // another thread modifies the vector is a race; is_current after reading confirms that what was read is
+    // consistent.
+    template <typename T>
+    struct vector_buffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only vectors of trivially copyable elements expose their storage.");
+
+        vector_buffer() noexcept = default;
+
+        explicit operator bool() const noexcept
+        {
+            return m_access != nullptr;
+        }
+
+        T const* data() const noexcept
+        {
+            return m_data;
+        }
+
+        uint32_t size() const noexcept
+        {
+            return m_size;
+        }
+
+        T const* begin() const noexcept
+        {
+            return m_data;
+        }
+
+        T const* end() const noexcept
+        {
+            return m_data + m_size;
+        }
+
+        T const& operator[](uint32_t const index) const noexcept
+        {
+            XLANG_ASSERT(index < m_size);
+            return m_data[index];
+        }
+
+        bool is_current() const noexcept
+        {
+            return m_access && m_access->GetVersion() == m_version;
+        }
+
+        void check_current() const
+        {
+            if (!is_current())
+            {
+                throw hresult_changed_state();
+            }
+        }
+
+    private:
+
+        template <typename U>
+        friend vector_buffer<U> try_get_buffer(Foundation::Collections::IVectorView<U> const& vector);
+
+        template <typename U>
+        friend vector_buffer<U> try_get_buffer(Foundation::Collections::IVector<U> const& vector);
+
+        explicit vector_buffer(Windows::Foundation::IUnknown const& vector)
+        {
+            com_ptr<impl::IVectorBufferAccess> access = vector.try_as<impl::IVectorBufferAccess>();
+            void const* data{};
+
+            if (access && access->GetBuffer(sizeof(T), &data, &m_size, &m_version) == impl::error_ok)
+            {
+                m_access = std::move(access);
+                m_data = static_cast<T const*>(data);
+            }
+        }
+
+        com_ptr<impl::IVectorBufferAccess> m_access;
+        T const* m_data{};
+        uint32_t m_size{};
+        uint32_t m_version{};
+    };
+
+    // Returns an empty vector_buffer, which converts to false, if the vector doesn't expose its storage.
+    template <typename T>
+    vector_buffer<T> try_get_buffer(Foundation::Collections::IVectorView<T> const& vector)
+    {
+        return vector_buffer<T>{ vector };
+    }
+
+    template <typename T>
+    vector_buffer<T> try_get_buffer(Foundation::Collections::IVector<T> const& vector)
+    {
+        return vector_buffer<T>{ vector };
+    }
 }
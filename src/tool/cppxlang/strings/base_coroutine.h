@@ -1,44 +1,5 @@
 
-#ifdef _WIN32
-namespace xlang::impl
-{
-    template <typename Async>
-    struct await_adapter
-    {
-        Async const& async;
-
-        bool await_ready() const
-        {
-            return async.Status() == Foundation::AsyncStatus::Completed;
-        }
-
-        void await_suspend(std::experimental::coroutine_handle<> handle) const
-        {
-            auto context = capture<IContextCallback>(XLANG_CoGetObjectContext);
-
-            async.Completed([handle, context = std::move(context)](auto const&, Foundation::AsyncStatus)
-            {
-                com_callback_args args{};
-                args.data = handle.address();
-
-                auto callback = [](com_callback_args* args) noexcept -> int32_t
-                {
-                    std::experimental::coroutine_handle<>::from_address(args->data)();
-                    return error_ok;
-                };
-
-                check_hresult(context->ContextCallback(callback, &args, guid_of<impl::ICallbackWithNoReentrancyToApplicationSTA>(), 5, nullptr));
-            });
-        }
-
-        auto await_resume() const
-        {
-            return async.GetResults();
-        }
-    };
-}
-
-#ifdef _RESUMABLE_FUNCTIONS_SUPPORTED
+#if !defined(_MSC_VER) || defined(_RESUMABLE_FUNCTIONS_SUPPORTED)
 namespace xlang::Foundation
 {
     inline impl::await_adapter<IAsyncAction> operator co_await(IAsyncAction const& async)
@@ -116,6 +77,11 @@ namespace xlang::impl
             m_promise->cancellation_callback(std::move(cancel));
         }
 
+        void cancel_after(Foundation::TimeSpan duration) const
+        {
+            m_promise->cancel_after(duration);
+        }
+
     private:
 
         Promise* m_promise;
@@ -153,8 +119,54 @@ namespace xlang::impl
         Promise* m_promise;
     };
 
+    // Maps an awaited expression to the adapter whose completion handler promise_base can embed in its own storage.
+    template <typename T>
+    struct embeddable_await
+    {
+    };
+
+    template <>
+    struct embeddable_await<Foundation::IAsyncAction>
+    {
+        using type = await_adapter<Foundation::IAsyncAction>;
+    };
+
+    template <typename TProgress>
+    struct embeddable_await<Foundation::IAsyncActionWithProgress<TProgress>>
+    {
+        using type = await_adapter<Foundation::IAsyncActionWithProgress<TProgress>>;
+    };
+
+    template <typename TResult>
+    struct embeddable_await<Foundation::IAsyncOperation<TResult>>
+    {
+        using type = await_adapter<Foundation::IAsyncOperation<TResult>>;
+    };
+
+    template <typename TResult, typename TProgress>
+    struct embeddable_await<Foundation::IAsyncOperationWithProgress<TResult, TProgress>>
+    {
+        using type = await_adapter<Foundation::IAsyncOperationWithProgress<TResult, TProgress>>;
+    };
+
+    template <typename Async, typename Executor>
+    struct embeddable_await<executor_await_adapter<Async, Executor>>
+    {
+        using type = executor_await_adapter<Async, Executor>;
+    };
+
+    template <typename T, typename = std::void_t<>>
+    struct is_embeddable_await : std::false_type
+    {
+    };
+
+    template <typename T>
+    struct is_embeddable_await<T, std::void_t<typename embeddable_await<T>::type>> : std::true_type
+    {
+    };
+
     template <typename Derived, typename AsyncInterface, typename CompletedHandler, typename TProgress = void>
-    struct promise_base : implements<Derived, AsyncInterface>
+    struct promise_base : implements<Derived, AsyncInterface>, recycled_frame
     {
         using AsyncStatus = Foundation::AsyncStatus;
 
@@ -238,18 +250,23 @@ namespace xlang::impl
             {
                 std::lock_guard const guard(m_lock);
 
-                if (m_status == AsyncStatus::Started)
+                if (m_status != AsyncStatus::Started)
                 {
-                    m_status = AsyncStatus::Canceled;
-                    m_exception = std::make_exception_ptr(hresult_canceled());
-                    cancel = std::move(m_cancel);
+                    return;
                 }
+
+                m_status = AsyncStatus::Canceled;
+                m_exception = std::make_exception_ptr(hresult_canceled());
+                cancel = std::move(m_cancel);
             }
 
             if (cancel)
             {
                 cancel();
             }
+
+            // Cancels the operation currently being awaited, if any.
+            m_cancellation.cancel();
         }
 
         void Close() const noexcept
@@ -360,14 +377,32 @@ namespace xlang::impl
         }
 
         template <typename Expression>
-        Expression&& await_transform(Expression&& expression)
+        decltype(auto) await_transform(Expression&& expression)
         {
-            if (Status() == AsyncStatus::Canceled)
+            if (m_cancellation.is_canceled())
             {
                 throw xlang::hresult_canceled();
             }
 
-            return std::forward<Expression>(expression);
+            using expression_type = std::decay_t<Expression>;
+
+            if constexpr (is_embeddable_await<expression_type>::value)
+            {
+                using adapter_type = typename embeddable_await<expression_type>::type;
+
+                if constexpr (std::is_same_v<adapter_type, expression_type>)
+                {
+                    return embedded_await_adapter<adapter_type>{ expression, this };
+                }
+                else
+                {
+                    return embedded_await_adapter<adapter_type>{ adapter_type{ expression }, this };
+                }
+            }
+            else
+            {
+                return std::forward<Expression>(expression);
+            }
         }
 
         cancellation_token<Derived> await_transform(get_cancellation_token_t) noexcept
@@ -380,6 +415,19 @@ namespace xlang::impl
             return{ static_cast<Derived*>(this) };
         }
 
+        void cancel_after(Foundation::TimeSpan duration)
+        {
+            [](weak_ref<AsyncInterface> weak, Foundation::TimeSpan duration) -> fire_and_forget
+            {
+                co_await resume_after(duration);
+
+                if (auto async = weak.get())
+                {
+                    async.Cancel();
+                }
+            }(make_weak(get_return_object()), duration);
+        }
+
         void cancellation_callback(xlang::delegate<>&& cancel) noexcept
         {
             {
@@ -397,6 +445,72 @@ namespace xlang::impl
 
     protected:
 
+        // Resumes the coroutine like Adapter, but constructs the completion handler in the promise rather than on
+        // the heap whenever the handler storage is free. Canceling the promise while suspended cancels the awaited
+        // operation.
+        template <typename Adapter>
+        struct embedded_await_adapter : Adapter
+        {
+            struct cancel_awaited
+            {
+                Adapter const* adapter;
+
+                void operator()() const noexcept
+                {
+                    try
+                    {
+                        adapter->async.Cancel();
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+            };
+
+            promise_base* promise;
+            std::optional<cancellation_registration<cancel_awaited>> propagation;
+
+            void await_suspend(std::experimental::coroutine_handle<> handle)
+            {
+                propagation.emplace(&promise->m_cancellation, cancel_awaited{ this });
+
+                if (!propagation->registered())
+                {
+                    (*propagation)();
+                }
+
+                using handler_type = decltype(this->async.Completed());
+                this->async.Completed(promise->template make_completed_handler<handler_type>(this->resume_handler(handle)));
+            }
+        };
+
+        template <typename Handler, typename H>
+        Handler make_completed_handler(H&& handler)
+        {
+            using delegate_type = delegate_t<Handler, embedded_handler<std::decay_t<H>>>;
+
+            if constexpr (sizeof(delegate_type) <= sizeof(m_handler_storage) && alignof(delegate_type) <= alignof(void*))
+            {
+                if (!m_handler_assigned.exchange(true, std::memory_order_acquire))
+                {
+                    // The handler holds a reference to the promise, so the storage outlives the handler.
+                    static_cast<Derived*>(this)->AddRef();
+                    embedded_handler<std::decay_t<H>> embedded{ { handler_released, this }, std::forward<H>(handler) };
+                    auto const result = ::new (m_handler_storage) delegate_type(std::move(embedded));
+                    return { static_cast<void*>(static_cast<abi_t<Handler>*>(result)), take_ownership_from_abi };
+                }
+            }
+
+            return std::forward<H>(handler);
+        }
+
+        static void handler_released(void* owner) noexcept
+        {
+            auto const that = static_cast<promise_base*>(owner);
+            that->m_handler_assigned.store(false, std::memory_order_release);
+            that->Release();
+        }
+
         void rethrow_if_failed() const
         {
             if (m_status == AsyncStatus::Error || m_status == AsyncStatus::Canceled)
@@ -411,7 +525,8 @@ namespace xlang::impl
         xlang::delegate<> m_cancel;
         AsyncStatus m_status{ AsyncStatus::Started };
         bool m_completed_assigned{ false };
+        std::atomic<bool> m_handler_assigned{ false };
+        void* m_handler_storage[8];
+        cancellation_state m_cancellation;
     };
 }
-
-#endif
\ No newline at end of file
@@ -0,0 +1,100 @@
+
+namespace xlang::impl
+{
+    struct inline_executor
+    {
+        void operator()(std::experimental::coroutine_handle<> handle) const
+        {
+            handle();
+        }
+    };
+
+    // Awaits an async object without blocking a thread. The Completed handler passes the coroutine handle to the
+    // executor, which decides where the coroutine resumes.
+    template <typename Async, typename Executor>
+    struct executor_await_adapter
+    {
+        Async const& async;
+        Executor executor;
+
+        bool await_ready() const
+        {
+            return async.Status() == decltype(async.Status())::Completed;
+        }
+
+        void await_suspend(std::experimental::coroutine_handle<> handle) const
+        {
+            async.Completed(resume_handler(handle));
+        }
+
+        auto resume_handler(std::experimental::coroutine_handle<> handle) const
+        {
+            return [handle, executor = executor](auto&&...)
+            {
+                executor(handle);
+            };
+        }
+
+        auto await_resume() const
+        {
+            return async.GetResults();
+        }
+    };
+
+#ifdef _WIN32
+    template <typename Async>
+    struct await_adapter
+    {
+        Async const& async;
+
+        bool await_ready() const
+        {
+            return async.Status() == decltype(async.Status())::Completed;
+        }
+
+        void await_suspend(std::experimental::coroutine_handle<> handle) const
+        {
+            async.Completed(resume_handler(handle));
+        }
+
+        auto resume_handler(std::experimental::coroutine_handle<> handle) const
+        {
+            auto context = capture<IContextCallback>(XLANG_CoGetObjectContext);
+
+            return [handle, context = std::move(context)](auto&&...)
+            {
+                com_callback_args args{};
+                args.data = handle.address();
+
+                auto callback = [](com_callback_args* args) noexcept -> int32_t
+                {
+                    std::experimental::coroutine_handle<>::from_address(args->data)();
+                    return error_ok;
+                };
+
+                check_hresult(context->ContextCallback(callback, &args, guid_of<impl::ICallbackWithNoReentrancyToApplicationSTA>(), 5, nullptr));
+            };
+        }
+
+        auto await_resume() const
+        {
+            return async.GetResults();
+        }
+    };
+#else
+    // There is no apartment to return to, so the coroutine resumes on the thread that completed the async object.
+    template <typename Async>
+    using await_adapter = executor_await_adapter<Async, inline_executor>;
+#endif
+}
+
+namespace xlang
+{
+    // Awaits the async object and resumes the coroutine by passing its handle to the executor, a function object
+    // taking a std::experimental::coroutine_handle<>.
+    template <typename Async, typename Executor>
+    [[nodiscard]] auto resume_with(Async const& async, Executor executor)
+    {
+        return impl::executor_await_adapter<Async, Executor>{ async, std::move(executor) };
+    }
+}
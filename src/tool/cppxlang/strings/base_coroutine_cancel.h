@@ -0,0 +1,493 @@
+
+namespace xlang::impl
+{
+    struct cancellation_node
+    {
+        void(*callback)(cancellation_node* node) noexcept;
+
+        // Called instead of callback if the state is destroyed while the node is still registered.
+        void(*abandon)(cancellation_node* node) noexcept {};
+
+        cancellation_node* previous{};
+        cancellation_node* next{};
+        bool linked{};
+    };
+
+    // Checking for cancellation is a single atomic load. Registrations are linked into a list guarded by a spin
+    // lock that is only held while a node is linked or unlinked, never while callbacks run.
+    struct cancellation_state
+    {
+        cancellation_state() noexcept = default;
+        cancellation_state(cancellation_state const&) = delete;
+        cancellation_state& operator=(cancellation_state const&) = delete;
+
+        ~cancellation_state()
+        {
+            while (cancellation_node* const node = m_head)
+            {
+                unlink(node);
+
+                if (node->abandon)
+                {
+                    node->abandon(node);
+                }
+            }
+        }
+
+        bool is_canceled() const noexcept
+        {
+            return m_canceled.load(std::memory_order_acquire);
+        }
+
+        // Runs the registered callbacks in the calling thread. Returns false if already canceled.
+        bool cancel() noexcept
+        {
+            lock();
+
+            if (m_canceled.load(std::memory_order_relaxed))
+            {
+                unlock();
+                return false;
+            }
+
+            m_canceled.store(true, std::memory_order_release);
+            m_canceling_thread = std::this_thread::get_id();
+
+            while (cancellation_node* const node = m_head)
+            {
+                unlink(node);
+                m_running.store(node, std::memory_order_relaxed);
+                unlock();
+
+                node->callback(node);
+                m_running.store(nullptr, std::memory_order_release);
+                lock();
+            }
+
+            unlock();
+            return true;
+        }
+
+        // Returns false, without linking the node, if already canceled.
+        bool add(cancellation_node* node) noexcept
+        {
+            lock();
+
+            if (m_canceled.load(std::memory_order_relaxed))
+            {
+                unlock();
+                return false;
+            }
+
+            node->previous = nullptr;
+            node->next = m_head;
+            node->linked = true;
+
+            if (m_head)
+            {
+                m_head->previous = node;
+            }
+
+            m_head = node;
+            unlock();
+            return true;
+        }
+
+        // Once remove returns, the node's callback isn't running and won't run, unless remove was called from
+        // within the callback itself.
+        void remove(cancellation_node* node) noexcept
+        {
+            lock();
+
+            if (node->linked)
+            {
+                unlink(node);
+                unlock();
+                return;
+            }
+
+            bool const wait = m_running.load(std::memory_order_relaxed) == node && m_canceling_thread != std::this_thread::get_id();
+            unlock();
+
+            if (wait)
+            {
+                while (m_running.load(std::memory_order_acquire) == node)
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+    private:
+
+        void lock() noexcept
+        {
+            while (m_lock.exchange(true, std::memory_order_acquire))
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        void unlock() noexcept
+        {
+            m_lock.store(false, std::memory_order_release);
+        }
+
+        void unlink(cancellation_node* node) noexcept
+        {
+            if (node->previous)
+            {
+                node->previous->next = node->next;
+            }
+            else
+            {
+                m_head = node->next;
+            }
+
+            if (node->next)
+            {
+                node->next->previous = node->previous;
+            }
+
+            node->linked = false;
+        }
+
+        std::atomic<bool> m_canceled{};
+        std::atomic<bool> m_lock{};
+        std::atomic<cancellation_node*> m_running{};
+        std::thread::id m_canceling_thread;
+        cancellation_node* m_head{};
+    };
+
+    // Registers a callback that must not throw. A callback isn't registered, and doesn't run, if the state is
+    // already canceled; registered() reports whether it was.
+    template <typename Callback>
+    struct cancellation_registration : cancellation_node
+    {
+        cancellation_registration(cancellation_state* state, Callback&& callback) :
+            cancellation_node{ invoke },
+            m_callback(std::move(callback))
+        {
+            if (state && state->add(this))
+            {
+                m_state = state;
+            }
+        }
+
+        ~cancellation_registration()
+        {
+            if (m_state)
+            {
+                m_state->remove(this);
+            }
+        }
+
+        cancellation_registration(cancellation_registration const&) = delete;
+        cancellation_registration& operator=(cancellation_registration const&) = delete;
+
+        bool registered() const noexcept
+        {
+            return m_state != nullptr;
+        }
+
+        void operator()() noexcept
+        {
+            m_callback();
+        }
+
+    private:
+
+        static void invoke(cancellation_node* node) noexcept
+        {
+            (*static_cast<cancellation_registration*>(node))();
+        }
+
+        cancellation_state* m_state{};
+        Callback m_callback;
+    };
+
+    struct cancellation_access
+    {
+        template <typename Token>
+        static auto const& state(Token const& token) noexcept
+        {
+            return token.m_state;
+        }
+    };
+}
+
+namespace xlang
+{
+    struct cancellation_token
+    {
+        // A default token can never be canceled.
+        cancellation_token() noexcept = default;
+
+        bool is_canceled() const noexcept
+        {
+            return m_state && m_state->is_canceled();
+        }
+
+        bool can_be_canceled() const noexcept
+        {
+            return m_state != nullptr;
+        }
+
+    private:
+
+        friend struct cancellation_source;
+        friend struct impl::cancellation_access;
+
+        explicit cancellation_token(std::shared_ptr<impl::cancellation_state> const& state) noexcept :
+            m_state(state)
+        {
+        }
+
+        std::shared_ptr<impl::cancellation_state> m_state;
+    };
+
+    struct cancellation_source
+    {
+        cancellation_source() :
+            m_state(std::make_shared<impl::cancellation_state>())
+        {
+        }
+
+        cancellation_token token() const noexcept
+        {
+            return cancellation_token{ m_state };
+        }
+
+        bool is_canceled() const noexcept
+        {
+            return m_state->is_canceled();
+        }
+
+        // Runs the registered callbacks in the calling thread. Returns false if already canceled.
+        bool cancel() const noexcept
+        {
+            return m_state->cancel();
+        }
+
+        // Cancels once the duration has elapsed, unless canceled earlier.
+        void cancel_after(Foundation::TimeSpan duration) const;
+
+    private:
+
+        std::shared_ptr<impl::cancellation_state> m_state;
+    };
+
+    // Runs the callback once the token is canceled, or right away if it already is. The callback must not throw.
+    // The destructor unregisters the callback and, if it is running on another thread, waits for it to finish.
+    template <typename Callback>
+    struct cancellation_callback
+    {
+        cancellation_callback(cancellation_token const& token, Callback callback) :
+            m_state(impl::cancellation_access::state(token)),
+            m_registration(m_state.get(), std::move(callback))
+        {
+            if (!m_registration.registered() && token.is_canceled())
+            {
+                m_registration();
+            }
+        }
+
+    private:
+
+        std::shared_ptr<impl::cancellation_state> m_state;
+        impl::cancellation_registration<Callback> m_registration;
+    };
+
+#ifndef _WIN32
+    // The timer only holds a weak reference to the state, and is removed from the reactor as soon as the state is
+    // canceled or destroyed, so abandoned deadlines don't keep anything alive.
+    inline void cancellation_source::cancel_after(Foundation::TimeSpan duration) const
+    {
+        struct deadline_timer : impl::cancellation_node
+        {
+            // One for the registration, one for the reactor, and one for cancel_after itself.
+            std::atomic<uint32_t> references{ 3 };
+            std::atomic<bool> armed{};
+            impl::reactor::timer_handle timer{};
+            std::weak_ptr<impl::cancellation_state> state;
+
+            void release() noexcept
+            {
+                if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+            // Whichever of arming and cancellation comes second removes the timer.
+            void disarm() noexcept
+            {
+                if (armed.exchange(true, std::memory_order_acq_rel) && impl::reactor::instance().remove_timer(timer))
+                {
+                    release();
+                }
+            }
+
+            static void canceled(impl::cancellation_node* node) noexcept
+            {
+                auto const that = static_cast<deadline_timer*>(node);
+                that->disarm();
+                that->release();
+            }
+
+            static void elapsed(void* context) noexcept
+            {
+                auto const that = static_cast<deadline_timer*>(context);
+
+                if (auto const state = that->state.lock())
+                {
+                    state->cancel();
+                }
+
+                that->release();
+            }
+        };
+
+        auto const deadline = impl::reactor::clock::now() + std::chrono::duration_cast<impl::reactor::clock::duration>(duration);
+        auto timer = std::make_unique<deadline_timer>();
+        timer->callback = deadline_timer::canceled;
+        timer->abandon = deadline_timer::canceled;
+        timer->state = m_state;
+
+        if (!m_state->add(timer.get()))
+        {
+            return;
+        }
+
+        deadline_timer* const that = timer.release();
+        that->timer = impl::reactor::instance().add_timer(deadline, { deadline_timer::elapsed, that });
+        that->disarm();
+        that->release();
+    }
+
+    // Resumes once the duration has elapsed or the token is canceled, whichever comes first. Returns true if the
+    // duration elapsed.
+    [[nodiscard]] inline auto resume_after(Foundation::TimeSpan duration, cancellation_token const& token)
+    {
+        struct timer_state
+        {
+            std::atomic<uint32_t> references{ 1 };
+            std::atomic<bool> resumed{};
+            std::atomic<bool> armed{};
+            bool canceled{};
+            impl::reactor::timer_handle timer{};
+            std::experimental::coroutine_handle<> handle;
+
+            void release() noexcept
+            {
+                if (references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                {
+                    delete this;
+                }
+            }
+
+            // Whichever of arming and cancellation comes second removes the timer, so that a canceled wait
+            // doesn't hold on to its state until the deadline.
+            void disarm() noexcept
+            {
+                if (armed.exchange(true, std::memory_order_acq_rel) && impl::reactor::instance().remove_timer(timer))
+                {
+                    release();
+                }
+            }
+        };
+
+        struct cancel_timer
+        {
+            timer_state* state;
+
+            void operator()() const noexcept
+            {
+                if (!state->resumed.exchange(true))
+                {
+                    state->canceled = true;
+                    state->disarm();
+                    impl::thread_pool::instance().submit({ impl::resume_handle, state->handle.address() });
+                }
+            }
+        };
+
+        struct awaitable
+        {
+            awaitable(Foundation::TimeSpan duration, std::shared_ptr<impl::cancellation_state> const& state) noexcept :
+                m_duration(duration),
+                m_cancellation(state)
+            {
+            }
+
+            ~awaitable()
+            {
+                m_registration.reset();
+
+                if (m_timer)
+                {
+                    m_timer->release();
+                }
+            }
+
+            bool await_ready() const noexcept
+            {
+                return m_duration.count() <= 0 || (m_cancellation && m_cancellation->is_canceled());
+            }
+
+            bool await_suspend(std::experimental::coroutine_handle<> handle)
+            {
+                auto const deadline = impl::reactor::clock::now() + std::chrono::duration_cast<impl::reactor::clock::duration>(m_duration);
+                timer_state* const timer = new timer_state;
+                timer->handle = handle;
+                m_timer = timer;
+                m_registration.emplace(m_cancellation.get(), cancel_timer{ timer });
+
+                if (m_cancellation && !m_registration->registered())
+                {
+                    timer->canceled = true;
+                    return false;
+                }
+
+                // Cancellation may resume the coroutine from here on, so only locals are used. The timer holds
+                // a reference until it completes or is removed, and this function holds one until it returns.
+                timer->references.fetch_add(2, std::memory_order_relaxed);
+                timer->timer = impl::reactor::instance().add_timer(deadline, { [](void* context) noexcept
+                {
+                    auto const timer = static_cast<timer_state*>(context);
+
+                    if (!timer->resumed.exchange(true))
+                    {
+                        timer->handle();
+                    }
+
+                    timer->release();
+                }, timer });
+
+                timer->disarm();
+                timer->release();
+                return true;
+            }
+
+            bool await_resume() const noexcept
+            {
+                if (m_timer)
+                {
+                    return !m_timer->canceled;
+                }
+
+                return !(m_cancellation && m_cancellation->is_canceled());
+            }
+
+        private:
+
+            Foundation::TimeSpan m_duration;
+            std::shared_ptr<impl::cancellation_state> m_cancellation;
+            timer_state* m_timer{};
+            std::optional<impl::cancellation_registration<cancel_timer>> m_registration;
+        };
+
+        return awaitable{ duration, impl::cancellation_access::state(token) };
+    }
+#endif
+}
@@ -0,0 +1,20 @@
+
+namespace xlang::impl
+{
+    // Recycles coroutine frames of up to 1KB.
+    using frame_cache = block_cache<64, 16, 64>;
+
+    // Promise types derive from recycled_frame to allocate their coroutine frames from the frame cache.
+    struct recycled_frame
+    {
+        static void* operator new(size_t size)
+        {
+            return frame_cache::allocate(size);
+        }
+
+        static void operator delete(void* frame, size_t size) noexcept
+        {
+            frame_cache::deallocate(frame, size);
+        }
+    };
+}
@@ -314,6 +314,15 @@ namespace xlang
 
         return awaitable{ dispatcher, priority };
     };
+
+    inline void cancellation_source::cancel_after(Foundation::TimeSpan duration) const
+    {
+        [](std::shared_ptr<impl::cancellation_state> state, Foundation::TimeSpan duration) -> fire_and_forget
+        {
+            co_await resume_after(duration);
+            state->cancel();
+        }(m_state, duration);
+    }
 }
 
 #endif
@@ -0,0 +1,485 @@
+
+#ifndef _WIN32
+namespace xlang::impl
+{
+    struct work_item
+    {
+        void(*callback)(void* context) noexcept;
+        void* context;
+    };
+
+    inline void resume_handle(void* context) noexcept
+    {
+        std::experimental::coroutine_handle<>::from_address(context)();
+    }
+
+    // A work stealing thread pool. Each worker runs the work it queued itself most recently first, and steals
+    // the oldest work from the other workers once its own queue is empty. Work queued from other threads is
+    // spread across the workers.
+    struct thread_pool
+    {
+        static thread_pool& instance()
+        {
+            // Intentionally leaked, so that workers never race with static destruction at exit.
+            static thread_pool* const pool = new thread_pool((std::max)(2u, std::thread::hardware_concurrency()));
+            return *pool;
+        }
+
+        void submit(work_item const& item)
+        {
+            worker_queue* queue = t_current_queue;
+
+            if (t_current_pool != this)
+            {
+                queue = &m_queues[m_next_queue.fetch_add(1, std::memory_order_relaxed) % m_count];
+            }
+
+            {
+                std::lock_guard const guard(queue->lock);
+                queue->items.push_back(item);
+            }
+
+            m_pending.fetch_add(1);
+
+            if (m_sleeping.load() != 0)
+            {
+                std::lock_guard const guard(m_sleep_lock);
+                m_wake.notify_one();
+            }
+        }
+
+    private:
+
+        struct alignas(64) worker_queue
+        {
+            std::mutex lock;
+            std::deque<work_item> items;
+        };
+
+        explicit thread_pool(uint32_t const count) :
+            m_queues(std::make_unique<worker_queue[]>(count)),
+            m_count(count)
+        {
+            for (uint32_t index = 0; index != count; ++index)
+            {
+                std::thread([this, index] { run(index); }).detach();
+            }
+        }
+
+        bool try_pop(uint32_t const index, work_item& item)
+        {
+            {
+                worker_queue& own = m_queues[index];
+                std::lock_guard const guard(own.lock);
+
+                if (!own.items.empty())
+                {
+                    item = own.items.back();
+                    own.items.pop_back();
+                    return true;
+                }
+            }
+
+            for (uint32_t offset = 1; offset != m_count; ++offset)
+            {
+                worker_queue& other = m_queues[(index + offset) % m_count];
+                std::lock_guard const guard(other.lock);
+
+                if (!other.items.empty())
+                {
+                    item = other.items.front();
+                    other.items.pop_front();
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void run(uint32_t const index)
+        {
+            t_current_pool = this;
+            t_current_queue = &m_queues[index];
+
+            while (true)
+            {
+                work_item item{};
+
+                if (try_pop(index, item))
+                {
+                    m_pending.fetch_sub(1);
+                    item.callback(item.context);
+                    continue;
+                }
+
+                // Workers announce that they are about to sleep before checking for pending work, and submit
+                // checks for sleeping workers after publishing new work, so a wakeup can't be missed.
+                std::unique_lock guard(m_sleep_lock);
+                m_sleeping.fetch_add(1);
+                m_wake.wait(guard, [&] { return m_pending.load() != 0; });
+                m_sleeping.fetch_sub(1);
+            }
+        }
+
+        inline static thread_local thread_pool* t_current_pool{};
+        inline static thread_local worker_queue* t_current_queue{};
+
+        std::unique_ptr<worker_queue[]> m_queues;
+        uint32_t const m_count;
+        std::atomic<uint32_t> m_next_queue{};
+        std::atomic<uint32_t> m_pending{};
+        std::atomic<uint32_t> m_sleeping{};
+        std::mutex m_sleep_lock;
+        std::condition_variable m_wake;
+    };
+
+    // Waits for timers and file descriptors on a dedicated thread, and hands completed waits to the thread pool,
+    // so that no coroutine ever runs on the reactor thread.
+    struct reactor
+    {
+        using clock = std::chrono::steady_clock;
+
+        static reactor& instance()
+        {
+            // Intentionally leaked, like the thread pool.
+            static reactor* const value = new reactor;
+            return *value;
+        }
+
+        struct timer_handle
+        {
+            clock::time_point deadline;
+            uint64_t id;
+        };
+
+        timer_handle add_timer(clock::time_point const deadline, work_item const& item)
+        {
+            timer_handle handle{ deadline, 0 };
+
+            {
+                std::lock_guard const guard(m_lock);
+                handle.id = ++m_last_timer;
+                m_timers.emplace(std::make_pair(deadline, handle.id), item);
+            }
+
+            wake();
+            return handle;
+        }
+
+        // Returns true if the timer was removed before it completed, in which case its work item never runs.
+        bool remove_timer(timer_handle const& handle)
+        {
+            std::lock_guard const guard(m_lock);
+            return m_timers.erase(std::make_pair(handle.deadline, handle.id)) != 0;
+        }
+
+        size_t timer_count()
+        {
+            std::lock_guard const guard(m_lock);
+            return m_timers.size();
+        }
+
+        // Completes with signaled set to true once the file descriptor is readable, or to false once the deadline
+        // has passed.
+        void add_wait(int const fd, clock::time_point const deadline, bool* const signaled, work_item const& item)
+        {
+            {
+                std::lock_guard const guard(m_lock);
+                m_waits.push_back({ fd, deadline, signaled, item });
+            }
+
+            wake();
+        }
+
+    private:
+
+        struct wait_entry
+        {
+            int fd;
+            clock::time_point deadline;
+            bool* signaled;
+            work_item item;
+        };
+
+        reactor()
+        {
+            int fds[2];
+
+            if (::pipe(fds) != 0)
+            {
+                throw std::system_error(errno, std::generic_category());
+            }
+
+            for (int const fd : fds)
+            {
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+                ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+            }
+
+            m_wake_read = fds[0];
+            m_wake_write = fds[1];
+            std::thread([this] { run(); }).detach();
+        }
+
+        void wake() noexcept
+        {
+            // A full pipe already guarantees a wakeup, so failures can be ignored.
+            char const signal{};
+            [[maybe_unused]] auto const written = ::write(m_wake_write, &signal, 1);
+        }
+
+        void run()
+        {
+            std::vector<pollfd> fds;
+            std::vector<work_item> ready;
+
+            while (true)
+            {
+                int timeout = -1;
+                fds.clear();
+                fds.push_back({ m_wake_read, POLLIN, 0 });
+
+                {
+                    std::lock_guard const guard(m_lock);
+                    auto const now = clock::now();
+
+                    while (!m_timers.empty() && m_timers.begin()->first.first <= now)
+                    {
+                        ready.push_back(m_timers.begin()->second);
+                        m_timers.erase(m_timers.begin());
+                    }
+
+                    auto next = m_timers.empty() ? clock::time_point::max() : m_timers.begin()->first.first;
+
+                    for (size_t index = 0; index != m_waits.size();)
+                    {
+                        if (m_waits[index].deadline <= now)
+                        {
+                            *m_waits[index].signaled = false;
+                            ready.push_back(m_waits[index].item);
+                            m_waits[index] = m_waits.back();
+                            m_waits.pop_back();
+                            continue;
+                        }
+
+                        next = (std::min)(next, m_waits[index].deadline);
+                        fds.push_back({ m_waits[index].fd, POLLIN, 0 });
+                        ++index;
+                    }
+
+                    if (next != clock::time_point::max())
+                    {
+                        auto const remaining = std::chrono::ceil<std::chrono::milliseconds>(next - now).count();
+                        timeout = static_cast<int>((std::min)(remaining, static_cast<std::remove_const_t<decltype(remaining)>>(std::numeric_limits<int>::max())));
+                    }
+                }
+
+                for (work_item const& item : ready)
+                {
+                    thread_pool::instance().submit(item);
+                }
+
+                ready.clear();
+
+                if (::poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout) <= 0)
+                {
+                    continue;
+                }
+
+                if (fds[0].revents != 0)
+                {
+                    char buffer[64];
+                    while (::read(m_wake_read, buffer, sizeof(buffer)) > 0)
+                    {
+                    }
+                }
+
+                std::lock_guard const guard(m_lock);
+
+                // Only this thread removes waits, and new waits are appended, so the waits polled for still
+                // start the list in the same order.
+                for (size_t index = fds.size() - 1; index != 0; --index)
+                {
+                    if (fds[index].revents != 0)
+                    {
+                        wait_entry& entry = m_waits[index - 1];
+                        *entry.signaled = true;
+                        ready.push_back(entry.item);
+                        entry = m_waits.back();
+                        m_waits.pop_back();
+                    }
+                }
+            }
+        }
+
+        std::mutex m_lock;
+        std::map<std::pair<clock::time_point, uint64_t>, work_item> m_timers;
+        uint64_t m_last_timer{};
+        std::vector<wait_entry> m_waits;
+        int m_wake_read{ -1 };
+        int m_wake_write{ -1 };
+    };
+}
+
+namespace xlang
+{
+    // An executor for resume_with that resumes coroutines on the thread pool.
+    struct background_executor
+    {
+        void operator()(std::experimental::coroutine_handle<> handle) const
+        {
+            impl::thread_pool::instance().submit({ impl::resume_handle, handle.address() });
+        }
+    };
+
+    [[nodiscard]] inline auto resume_background() noexcept
+    {
+        struct awaitable
+        {
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> handle) const
+            {
+                impl::thread_pool::instance().submit({ impl::resume_handle, handle.address() });
+            }
+        };
+
+        return awaitable{};
+    }
+
+    template <typename T>
+    [[nodiscard]] auto resume_background(T const& context) noexcept
+    {
+        struct awaitable
+        {
+            awaitable(T const& context) : m_context(context)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return false;
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> resume)
+            {
+                m_resume = resume;
+                impl::thread_pool::instance().submit({ callback, this });
+            }
+
+        private:
+
+            static void callback(void* context) noexcept
+            {
+                auto that = static_cast<awaitable*>(context);
+                // The guard returned by the context stays alive while the coroutine runs.
+                [[maybe_unused]] auto const guard = that->m_context();
+                that->m_resume();
+            }
+
+            T const& m_context;
+            std::experimental::coroutine_handle<> m_resume{ nullptr };
+        };
+
+        return awaitable{ context };
+    }
+
+    [[nodiscard]] inline auto resume_after(Foundation::TimeSpan duration) noexcept
+    {
+        struct awaitable
+        {
+            explicit awaitable(Foundation::TimeSpan duration) noexcept :
+                m_duration(duration)
+            {
+            }
+
+            bool await_ready() const noexcept
+            {
+                return m_duration.count() <= 0;
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> handle)
+            {
+                auto const deadline = impl::reactor::clock::now() + std::chrono::duration_cast<impl::reactor::clock::duration>(m_duration);
+                impl::reactor::instance().add_timer(deadline, { impl::resume_handle, handle.address() });
+            }
+
+            void await_resume() const noexcept
+            {
+            }
+
+            Foundation::TimeSpan m_duration;
+        };
+
+        return awaitable{ duration };
+    }
+
+    inline auto operator co_await(Foundation::TimeSpan duration)
+    {
+        return resume_after(duration);
+    }
+
+    // Resumes once the file descriptor is readable, such as an eventfd or the read end of a pipe, or once the
+    // timeout has elapsed. A zero timeout waits indefinitely. Returns true if the file descriptor was signaled.
+    [[nodiscard]] inline auto resume_on_signal(int fd, Foundation::TimeSpan timeout = {}) noexcept
+    {
+        struct awaitable
+        {
+            awaitable(int fd, Foundation::TimeSpan timeout) noexcept :
+                m_timeout(timeout),
+                m_fd(fd)
+            {}
+
+            bool await_ready() noexcept
+            {
+                pollfd entry{ m_fd, POLLIN, 0 };
+                m_signaled = ::poll(&entry, 1, 0) > 0;
+                return m_signaled;
+            }
+
+            void await_suspend(std::experimental::coroutine_handle<> resume)
+            {
+                m_resume = resume;
+                auto deadline = impl::reactor::clock::time_point::max();
+
+                if (m_timeout.count() > 0)
+                {
+                    deadline = impl::reactor::clock::now() + std::chrono::duration_cast<impl::reactor::clock::duration>(m_timeout);
+                }
+
+                impl::reactor::instance().add_wait(m_fd, deadline, &m_signaled, { callback, this });
+            }
+
+            bool await_resume() const noexcept
+            {
+                return m_signaled;
+            }
+
+        private:
+
+            static void callback(void* context) noexcept
+            {
+                static_cast<awaitable*>(context)->m_resume();
+            }
+
+            Foundation::TimeSpan m_timeout;
+            int m_fd;
+            bool m_signaled{};
+            std::experimental::coroutine_handle<> m_resume{ nullptr };
+        };
+
+        return awaitable{ fd, timeout };
+    }
+}
+#endif
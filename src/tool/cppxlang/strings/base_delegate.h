@@ -1,11 +1,188 @@
 
 namespace xlang::impl
 {
+    // Recycles small blocks of memory. Freed blocks are kept on per-thread free lists, one for each size class, and
+    // handed to the next allocation of a similar size on the same thread. Larger blocks, and blocks freed once a
+    // list is full, go straight back to the PAL allocator. Each instantiation keeps its own lists.
+    template <size_t Granularity, size_t SizeClasses, uint32_t MaxCached>
+    struct block_cache
+    {
+        static constexpr size_t granularity = Granularity;
+        static constexpr size_t size_classes = SizeClasses;
+        static constexpr uint32_t max_cached = MaxCached;
+
+        static void* allocate(size_t size)
+        {
+            size_t const index = size_class(size);
+
+            if (index < size_classes)
+            {
+                // Always allocate the whole size class. The block may be freed on a thread whose cache is alive and
+                // handed to any later allocation of that class.
+                size = (index + 1) * granularity;
+
+                if (!t_destroyed)
+                {
+                    free_list& list = local().lists[index];
+
+                    if (list.head)
+                    {
+                        node* const result = list.head;
+                        list.head = result->next;
+                        --list.count;
+                        return result;
+                    }
+                }
+            }
+
+            void* const result = xlang_mem_alloc(size);
+
+            if (!result)
+            {
+                throw std::bad_alloc();
+            }
+
+            return result;
+        }
+
+        static void deallocate(void* block, size_t size) noexcept
+        {
+            size_t const index = size_class(size);
+
+            if (index < size_classes && !t_destroyed)
+            {
+                free_list& list = local().lists[index];
+
+                if (list.count < max_cached)
+                {
+                    list.head = new (block) node{ list.head };
+                    ++list.count;
+                    return;
+                }
+            }
+
+            xlang_mem_free(block);
+        }
+
+    private:
+
+        struct node
+        {
+            node* next;
+        };
+
+        struct free_list
+        {
+            node* head{};
+            uint32_t count{};
+        };
+
+        struct cache
+        {
+            ~cache()
+            {
+                t_destroyed = true;
+
+                for (free_list& list : lists)
+                {
+                    while (list.head)
+                    {
+                        node* const next = list.head->next;
+                        xlang_mem_free(list.head);
+                        list.head = next;
+                    }
+                }
+            }
+
+            free_list lists[size_classes];
+        };
+
+        static size_t size_class(size_t const size) noexcept
+        {
+            return (size + granularity - 1) / granularity - 1;
+        }
+
+        static cache& local() noexcept
+        {
+            static thread_local cache value;
+            return value;
+        }
+
+        // Blocks may still be freed by other thread_local destructors once the cache is gone.
+        inline static thread_local bool t_destroyed{};
+    };
+
+    // Recycles delegates of up to 128 bytes, which covers handlers capturing a few pointers or a com_ptr.
+    using delegate_cache = block_cache<16, 8, 64>;
+
+    // Counts the references to a delegate. Increments are always atomic since several threads may copy the same
+    // delegate object at once. Releasing the last reference skips the read-modify-write: a count of one means the
+    // caller holds the only reference, and nothing else can take a new one without going through it.
+    struct delegate_reference_count
+    {
+        uint32_t increment() noexcept
+        {
+            return 1 + m_value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        uint32_t decrement() noexcept
+        {
+            // Pairs with the release of any reference that was dropped on another thread.
+            if (m_value.load(std::memory_order_acquire) == 1)
+            {
+                return 0;
+            }
+
+            uint32_t const target = m_value.fetch_sub(1, std::memory_order_release) - 1;
+
+            if (target == 0)
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+            }
+
+            return target;
+        }
+
+    private:
+
+        std::atomic<uint32_t> m_value{ 1 };
+    };
+
+    // Handlers deriving from embedded_delegate are constructed in storage provided by an owner rather than on the
+    // heap. Releasing the last reference destroys the delegate in place and calls back into the owner.
+    struct embedded_delegate
+    {
+        void(*released)(void* owner) noexcept;
+        void* owner;
+    };
+
+    template <typename H>
+    struct embedded_handler : embedded_delegate, H
+    {
+        embedded_handler(embedded_delegate const& owner, H&& handler) :
+            embedded_delegate(owner),
+            H(std::move(handler))
+        {
+        }
+
+        using H::operator();
+    };
+
     template <typename T, typename H>
     struct implements_delegate : abi_t<T>, H
     {
         implements_delegate(H&& handler) : H(std::forward<H>(handler)) {}
 
+        static void* operator new(size_t size)
+        {
+            return delegate_cache::allocate(size);
+        }
+
+        static void operator delete(void* block, size_t size) noexcept
+        {
+            delegate_cache::deallocate(block, size);
+        }
+
         int32_t XLANG_CALL QueryInterface(guid const& id, void** result) noexcept final
         {
             if (is_guid_of<T>(id) || is_guid_of<Windows::Foundation::IUnknown>(id))
@@ -21,17 +198,25 @@ namespace xlang::impl
 
         uint32_t XLANG_CALL AddRef() noexcept final
         {
-            return 1 + m_references.fetch_add(1, std::memory_order_relaxed);
+            return m_references.increment();
         }
 
         uint32_t XLANG_CALL Release() noexcept final
         {
-            uint32_t const target = m_references.fetch_sub(1, std::memory_order_release) - 1;
+            uint32_t const target = m_references.decrement();
 
             if (target == 0)
             {
-                std::atomic_thread_fence(std::memory_order_acquire);
-                delete static_cast<delegate_t<T, H>*>(this);
+                if constexpr (std::is_base_of_v<embedded_delegate, H>)
+                {
+                    embedded_delegate const owner = *this;
+                    std::destroy_at(static_cast<delegate_t<T, H>*>(this));
+                    owner.released(owner.owner);
+                }
+                else
+                {
+                    delete static_cast<delegate_t<T, H>*>(this);
+                }
             }
 
             return target;
@@ -39,7 +224,7 @@ namespace xlang::impl
 
     private:
 
-        std::atomic<uint32_t> m_references{ 1 };
+        delegate_reference_count m_references;
     };
 
     template <typename T, typename H>
@@ -59,6 +244,16 @@ namespace xlang::impl
     {
         variadic_delegate(H&& handler) : H(std::forward<H>(handler)) {}
 
+        static void* operator new(size_t size)
+        {
+            return delegate_cache::allocate(size);
+        }
+
+        static void operator delete(void* block, size_t size) noexcept
+        {
+            delegate_cache::deallocate(block, size);
+        }
+
         void invoke(T const&... args) final
         {
             (*this)(args...);
@@ -79,16 +274,15 @@ namespace xlang::impl
 
         uint32_t XLANG_CALL AddRef() noexcept final
         {
-            return 1 + m_references.fetch_add(1, std::memory_order_relaxed);
+            return m_references.increment();
         }
 
         uint32_t XLANG_CALL Release() noexcept final
         {
-            uint32_t const target = m_references.fetch_sub(1, std::memory_order_release) - 1;
+            uint32_t const target = m_references.decrement();
 
             if (target == 0)
             {
-                std::atomic_thread_fence(std::memory_order_acquire);
                 delete this;
             }
 
@@ -97,7 +291,7 @@ namespace xlang::impl
 
     private:
 
-        std::atomic<uint32_t> m_references{ 1 };
+        delegate_reference_count m_references;
     };
 }
 
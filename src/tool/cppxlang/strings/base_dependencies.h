@@ -8,6 +8,7 @@
 #include <cinttypes>
 #include <condition_variable>
 #include <cstddef>
+#include <cstring>
 #include <cwchar>
 #include <iterator>
 #include <limits>
@@ -20,10 +21,18 @@
 #include <string>
 #include <string_view>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <unordered_map>
 #include <vector>
 
+#ifndef _WIN32
+#include <deque>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
 #include <pal.h>
@@ -259,6 +259,9 @@ namespace xlang::impl
         return { static_cast<D const&>(*source), token };
     }
 
+    // Targets beyond size() are spare capacity. The event appends to the spare capacity of its current array in
+    // place, which is safe for concurrent readers because an element is only counted in size() once it has been
+    // assigned. Elements within size() are never modified.
     template <typename T>
     struct event_array
     {
@@ -267,9 +270,10 @@ namespace xlang::impl
         using pointer = value_type*;
         using iterator = value_type*;
 
-        explicit event_array(uint32_t const count) noexcept : m_size(count)
+        explicit event_array(uint32_t const count, uint32_t const capacity) noexcept : m_size(count), m_capacity(capacity)
         {
-            std::uninitialized_fill_n(data(), count, value_type());
+            XLANG_ASSERT(count <= capacity);
+            std::uninitialized_fill_n(data(), capacity, value_type());
         }
 
         unsigned long AddRef() noexcept
@@ -293,8 +297,8 @@ namespace xlang::impl
 
         reference back() noexcept
         {
-            XLANG_ASSERT(m_size > 0);
-            return*(data() + m_size - 1);
+            XLANG_ASSERT(size() > 0);
+            return*(data() + size() - 1);
         }
 
         iterator begin() noexcept
@@ -304,17 +308,32 @@ namespace xlang::impl
 
         iterator end() noexcept
         {
-            return data() + m_size;
+            return data() + size();
         }
 
         uint32_t size() const noexcept
         {
-            return m_size;
+            return m_size.load(std::memory_order_acquire);
+        }
+
+        uint32_t capacity() const noexcept
+        {
+            return m_capacity;
+        }
+
+        // Only the event's writer may append, and only to the array it has published.
+        template <typename InputIt>
+        void append(InputIt first, uint32_t const count) noexcept
+        {
+            uint32_t const current = m_size.load(std::memory_order_relaxed);
+            XLANG_ASSERT(count <= m_capacity - current);
+            std::copy_n(first, count, data() + current);
+            m_size.store(current + count, std::memory_order_release);
         }
 
         ~event_array() noexcept
         {
-            std::destroy(begin(), end());
+            std::destroy(data(), data() + m_capacity);
         }
 
     private:
@@ -325,15 +344,16 @@ namespace xlang::impl
         }
 
         std::atomic<uint32_t> m_references{ 1 };
-        uint32_t m_size{ 0 };
+        std::atomic<uint32_t> m_size{ 0 };
+        uint32_t const m_capacity{ 0 };
     };
 
     template <typename T>
-    com_ptr<event_array<T>> make_event_array(uint32_t const capacity)
+    com_ptr<event_array<T>> make_event_array(uint32_t const count, uint32_t const capacity)
     {
         void* raw = ::operator new(sizeof(event_array<T>) + (sizeof(T)* capacity));
 #pragma warning(suppress: 6386)
-        return { new(raw) event_array<T>(capacity), take_ownership_from_abi };
+        return { new(raw) event_array<T>(count, capacity), take_ownership_from_abi };
     }
 }
 
@@ -348,143 +368,299 @@ namespace xlang
         event(event<Delegate> const&) = delete;
         event<Delegate>& operator =(event<Delegate> const&) = delete;
 
+        ~event() noexcept
+        {
+            if (auto const targets = m_targets.load(std::memory_order_relaxed))
+            {
+                targets->Release();
+            }
+        }
+
         explicit operator bool() const noexcept
         {
-            return m_targets != nullptr;
+            return m_targets.load(std::memory_order_relaxed) != nullptr;
         }
 
         event_token add(delegate_type const& delegate)
         {
-            event_token token{};
+            append(&delegate, 1);
+            return get_token(delegate);
+        }
 
-            // Extends life of old targets array to release delegates outside of lock.
-            delegate_array temp_targets;
+        // Adds several handlers at once, returning their tokens in the same order. The targets array grows
+        // geometrically, so adding N handlers one at a time or in ranges takes amortized O(N) time.
+        std::vector<event_token> add_range(array_view<delegate_type const> delegates)
+        {
+            std::vector<event_token> tokens;
+            tokens.reserve(delegates.size());
 
+            for (delegate_type const& delegate : delegates)
             {
-                std::lock_guard const change_guard(m_change);
-                delegate_array new_targets = impl::make_event_array<delegate_type>((!m_targets) ? 1 : m_targets->size() + 1);
+                tokens.push_back(get_token(delegate));
+            }
+
+            append(delegates.begin(), delegates.size());
+            return tokens;
+        }
+
+        void remove(event_token const token)
+        {
+            erase(token.value);
+        }
+
+        // Removes the handlers for several tokens at once. Like remove, each token removes a single handler,
+        // and unknown tokens are ignored.
+        void remove_range(array_view<event_token const> tokens)
+        {
+            std::vector<int64_t> values;
+            values.reserve(tokens.size());
+
+            for (event_token const& token : tokens)
+            {
+                values.push_back(token.value);
+            }
+
+            std::sort(values.begin(), values.end());
+            erase(values.data(), static_cast<uint32_t>(values.size()));
+        }
+
+        template<typename...Arg>
+        void operator()(Arg const&... args)
+        {
+            delegate_array temp_targets = acquire_targets();
+
+            if (temp_targets)
+            {
+                for (delegate_type const& element : *temp_targets)
+                {
+                    bool remove_delegate = false;
+
+                    try
+                    {
+                        element(args...);
+                    }
+                    catch (hresult_error const& e)
+                    {
+                        if (e.code() == static_cast<int32_t>(0x80010108) || // RPC_E_DISCONNECTED
+                            e.code() == static_cast<int32_t>(0x800706BA) || // HRESULT_FROM_WIN32(RPC_S_SERVER_UNAVAILABLE)
+                            e.code() ==  static_cast<int32_t>(0x89020001))  // JSCRIPT_E_CANTEXECUTE
+                        {
+                            remove_delegate = true;
+                        }
+                    }
+
+                    if (remove_delegate)
+                    {
+                        remove(get_token(element));
+                    }
+                }
+            }
+        }
+
+    private:
+
+        using delegate_array = com_ptr<impl::event_array<delegate_type>>;
 
-                if (m_targets)
+        event_token get_token(delegate_type const& delegate) const noexcept
+        {
+            return event_token{ reinterpret_cast<int64_t>(get_abi(delegate)) };
+        }
+
+        // Invocation doesn't lock. Readers announce themselves in the reader count of the current epoch for
+        // just long enough to add a reference to the targets array, and writers retire an array only once the
+        // epoch it was published in has no readers left. Flipping the epoch on every change ensures that new
+        // readers can't keep a writer waiting. All operations on m_epoch, m_readers and m_targets are
+        // sequentially consistent, which is what makes the epoch check below sufficient.
+        delegate_array acquire_targets() noexcept
+        {
+            uint32_t epoch = m_epoch.load();
+
+            while (true)
+            {
+                m_readers[epoch].fetch_add(1);
+                uint32_t const current = m_epoch.load();
+
+                if (current == epoch)
                 {
-                    std::copy_n(m_targets->begin(), m_targets->size(), new_targets->begin());
+                    break;
                 }
 
-                new_targets->back() = delegate;
-                token = get_token(new_targets->back());
+                m_readers[epoch].fetch_sub(1);
+                epoch = current;
+            }
+
+            delegate_array result;
 
-                std::lock_guard const swap_guard(m_swap);
-                temp_targets = std::exchange(m_targets, std::move(new_targets));
+            if (auto const targets = m_targets.load())
+            {
+                targets->AddRef();
+                result.attach(targets);
             }
 
-            return token;
+            m_readers[epoch].fetch_sub(1, std::memory_order_release);
+            return result;
         }
 
-        void remove(event_token const token)
+        void append(delegate_type const* const delegates, uint32_t const count)
         {
+            if (count == 0)
+            {
+                return;
+            }
+
             // Extends life of old targets array to release delegates outside of lock.
             delegate_array temp_targets;
 
             {
                 std::lock_guard const change_guard(m_change);
+                auto const targets = m_targets.load(std::memory_order_relaxed);
+                uint32_t const size = targets ? targets->size() : 0;
 
-                if (!m_targets)
+                if (targets && targets->capacity() - size >= count)
                 {
-                    return;
+                    targets->append(delegates, count);
                 }
-
-                uint32_t available_slots = m_targets->size() - 1;
-                delegate_array new_targets;
-                bool removed = false;
-
-                if (available_slots == 0)
+                else
                 {
-                    if (get_token(*m_targets->begin()) == token)
+                    delegate_array new_targets = impl::make_event_array<delegate_type>(0, (std::max)(size + count, size * 2));
+
+                    if (targets)
                     {
-                        removed = true;
+                        new_targets->append(targets->begin(), size);
                     }
+
+                    new_targets->append(delegates, count);
+                    temp_targets = publish(std::move(new_targets));
                 }
-                else
+            }
+        }
+
+        // Removes the first handler with the token value. Unlike removing several tokens, this needs no
+        // bookkeeping beyond the position of the handler.
+        void erase(int64_t const value)
+        {
+            // Extends life of old targets array to release delegates outside of lock.
+            delegate_array temp_targets;
+
+            {
+                std::lock_guard const change_guard(m_change);
+                auto const targets = m_targets.load(std::memory_order_relaxed);
+
+                if (!targets)
                 {
-                    new_targets = impl::make_event_array<delegate_type>(available_slots);
-                    auto new_iterator = new_targets->begin();
+                    return;
+                }
 
-                    for (delegate_type const& element : *m_targets)
-                    {
-                        if (!removed && token == get_token(element))
-                        {
-                            removed = true;
-                            continue;
-                        }
+                uint32_t const size = targets->size();
+                uint32_t index = 0;
 
-                        if (available_slots == 0)
-                        {
-                            XLANG_ASSERT(!removed);
-                            break;
-                        }
+                while (index != size && get_token(targets->begin()[index]).value != value)
+                {
+                    ++index;
+                }
 
-                        *new_iterator = element;
-                        ++new_iterator;
-                        --available_slots;
-                    }
+                if (index == size)
+                {
+                    return;
                 }
 
-                if (removed)
+                delegate_array new_targets;
+
+                if (size != 1)
                 {
-                    std::lock_guard const swap_guard(m_swap);
-                    temp_targets = std::exchange(m_targets, std::move(new_targets));
+                    new_targets = impl::make_event_array<delegate_type>(0, size - 1);
+                    new_targets->append(targets->begin(), index);
+                    new_targets->append(targets->begin() + index + 1, size - index - 1);
                 }
+
+                temp_targets = publish(std::move(new_targets));
             }
         }
 
-        template<typename...Arg>
-        void operator()(Arg const&... args)
+        // Removes one handler for each of the sorted token values.
+        void erase(int64_t const* const values, uint32_t const count)
         {
-            delegate_array temp_targets;
-
+            if (count == 0)
             {
-                std::lock_guard const swap_guard(m_swap);
-                temp_targets = m_targets;
+                return;
             }
 
-            if (temp_targets)
+            // Extends life of old targets array to release delegates outside of lock.
+            delegate_array temp_targets;
+
             {
-                for (delegate_type const& element : *temp_targets)
+                std::lock_guard const change_guard(m_change);
+                auto const targets = m_targets.load(std::memory_order_relaxed);
+
+                if (!targets)
                 {
-                    bool remove_delegate = false;
+                    return;
+                }
 
-                    try
+                uint32_t const size = targets->size();
+                std::vector<bool> removed(size);
+
+                // Tokens only repeat when the same delegate was added more than once, so the number of matches
+                // for each distinct value is tracked at the first occurrence of the value.
+                std::vector<uint32_t> matched(count);
+                uint32_t removed_count = 0;
+
+                for (uint32_t index = 0; index != size && removed_count != count; ++index)
+                {
+                    int64_t const value = get_token(targets->begin()[index]).value;
+                    auto const [first, last] = std::equal_range(values, values + count, value);
+
+                    if (first != last && matched[first - values] < static_cast<uint32_t>(last - first))
                     {
-                        element(args...);
+                        ++matched[first - values];
+                        removed[index] = true;
+                        ++removed_count;
                     }
-                    catch (hresult_error const& e)
+                }
+
+                if (removed_count == 0)
+                {
+                    return;
+                }
+
+                delegate_array new_targets;
+
+                if (removed_count != size)
+                {
+                    new_targets = impl::make_event_array<delegate_type>(0, size - removed_count);
+
+                    for (uint32_t index = 0; index != size; ++index)
                     {
-                        if (e.code() == static_cast<int32_t>(0x80010108) || // RPC_E_DISCONNECTED
-                            e.code() == static_cast<int32_t>(0x800706BA) || // HRESULT_FROM_WIN32(RPC_S_SERVER_UNAVAILABLE)
-                            e.code() ==  static_cast<int32_t>(0x89020001))  // JSCRIPT_E_CANTEXECUTE
+                        if (!removed[index])
                         {
-                            remove_delegate = true;
+                            new_targets->append(targets->begin() + index, 1);
                         }
                     }
-
-                    if (remove_delegate)
-                    {
-                        remove(get_token(element));
-                    }
                 }
+
+                temp_targets = publish(std::move(new_targets));
             }
         }
 
-    private:
-
-        event_token get_token(delegate_type const& delegate) const noexcept
+        // Called with m_change held. Returns the previous targets array once no reader can still reach it.
+        delegate_array publish(delegate_array&& new_targets) noexcept
         {
-            return event_token{ reinterpret_cast<int64_t>(get_abi(delegate)) };
-        }
+            delegate_array old_targets{ m_targets.exchange(new_targets.detach()), take_ownership_from_abi };
 
-        using delegate_array = com_ptr<impl::event_array<delegate_type>>;
+            uint32_t const epoch = m_epoch.load(std::memory_order_relaxed);
+            m_epoch.store(epoch ^ 1);
+
+            while (m_readers[epoch].load(std::memory_order_acquire) != 0)
+            {
+                std::this_thread::yield();
+            }
+
+            return old_targets;
+        }
 
-        delegate_array m_targets;
-        std::mutex m_swap;
+        std::atomic<impl::event_array<delegate_type>*> m_targets{};
+        std::atomic<uint32_t> m_epoch{};
+        std::atomic<uint32_t> m_readers[2]{};
         std::mutex m_change;
     };
 }
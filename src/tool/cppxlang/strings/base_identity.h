@@ -465,6 +465,14 @@ namespace xlang::impl
         static constexpr guid value{ generate_guid(signature<T>::data) };
     };
 
+    // The bulk properties interface of I has a guid of its own, derived from the guid of I.
+    template <typename I>
+    struct bulk_properties_guid
+    {
+#pragma warning(suppress: 4307)
+        static constexpr guid value{ generate_guid(combine(u8"bulkproperties(", to_array<xlang_char8>(guid_of<I>()), u8")")) };
+    };
+
     template <>
     struct name<bool>
     {
@@ -331,6 +331,15 @@ namespace xlang::impl
     template <typename T>
     using uncloaked_interfaces = filter<is_uncloaked_interface, typename T::implements_type>;
 
+    template <typename I, typename = void>
+    struct has_bulk_properties : std::false_type {};
+    template <typename I>
+    struct has_bulk_properties<I, std::void_t<bulk_properties_abi_t<I>>> : std::true_type {};
+    template <typename T>
+    struct is_bulk_properties_interface : std::conjunction<is_interface<T>, has_bulk_properties<xlang::impl::uncloak<T>>> {};
+    template <typename T>
+    using bulk_properties_interfaces = filter<is_bulk_properties_interface, typename T::implements_type>;
+
     template <typename T, typename = void>
     struct implements_default_interface
     {
@@ -349,21 +358,94 @@ namespace xlang::impl
         using type = typename implements_default_interface<T>::type;
     };
 
-    struct iid_finder
+    // The implemented interfaces, followed by the bulk properties interfaces of those that have them, sorted by the
+    // first word of their guids, so that QueryInterface finds an interface with a binary search rather than comparing
+    // guids one interface at a time.
+    template <typename T, typename List, typename BulkList>
+    struct iid_table;
+
+    template <typename T, typename... I, typename... B>
+    struct iid_table<T, interface_list<I...>, interface_list<B...>>
     {
-        const guid& m_guid;
+        struct entry
+        {
+            guid iid;
+            void* (*cast)(const T* obj) noexcept;
+        };
 
-        template <typename I>
-        constexpr bool test() const noexcept
+        static void* find(const T* obj, const guid& iid) noexcept
         {
-            return is_guid_of<typename default_interface<I>::type>(m_guid);
+            size_t first = 0;
+            size_t count = entries.size();
+
+            while (count != 0)
+            {
+                size_t const half = count / 2;
+
+                if (entries[first + half].iid.Data1 < iid.Data1)
+                {
+                    first += half + 1;
+                    count -= half + 1;
+                }
+                else
+                {
+                    count = half;
+                }
+            }
+
+            for (; first != entries.size() && entries[first].iid.Data1 == iid.Data1; ++first)
+            {
+                if (entries[first].iid == iid)
+                {
+                    return entries[first].cast(obj);
+                }
+            }
+
+            return nullptr;
+        }
+
+    private:
+
+        template <typename Interface>
+        static void* cast(const T* obj) noexcept
+        {
+            return to_abi<Interface>(obj);
+        }
+
+        template <typename Interface>
+        static void* cast_bulk_properties(const T* obj) noexcept
+        {
+            return static_cast<bulk_properties_abi_t<Interface>*>(reinterpret_cast<produce<T, Interface>*>(to_abi<Interface>(obj)));
+        }
+
+        // An insertion sort is stable, so the first of several interfaces sharing a guid is still the one found.
+        static constexpr std::array<entry, sizeof...(I) + sizeof...(B)> sort() noexcept
+        {
+            std::array<entry, sizeof...(I) + sizeof...(B)> result{ entry{ guid_of<I>(), cast<I> }..., entry{ bulk_properties_guid<B>::value, cast_bulk_properties<B> }... };
+
+            for (size_t index = 1; index < result.size(); ++index)
+            {
+                entry const value = result[index];
+                size_t position = index;
+
+                for (; position != 0 && result[position - 1].iid.Data1 > value.iid.Data1; --position)
+                {
+                    result[position] = result[position - 1];
+                }
+
+                result[position] = value;
+            }
+
+            return result;
         }
+
+        static constexpr std::array<entry, sizeof...(I) + sizeof...(B)> entries{ sort() };
     };
 
     template <typename T>
     auto find_iid(const T* obj, const guid& iid) noexcept
     {
-        return static_cast<unknown_abi*>(implemented_interfaces<T>::find(obj, iid_finder{ iid }));
+        return static_cast<unknown_abi*>(iid_table<T, implemented_interfaces<T>, bulk_properties_interfaces<T>>::find(obj, iid));
     }
 
     struct xlang_object_finder
@@ -449,6 +531,44 @@ namespace xlang::impl
         }
     };
 
+    // Producers of an interface with bulk properties also implement its bulk properties interface. That interface has
+    // a guid of its own and is found with QueryInterface, so the vtable of the interface itself is left as described
+    // by its metadata.
+    template <typename D, typename I>
+    struct produce_bulk_properties_base : produce_base<D, I>, bulk_properties_abi_t<I>
+    {
+        int32_t XLANG_CALL QueryInterface(guid const& id, void** object) noexcept final
+        {
+            return this->shim().QueryInterface(id, object);
+        }
+
+        uint32_t XLANG_CALL AddRef() noexcept final
+        {
+            return this->shim().AddRef();
+        }
+
+        uint32_t XLANG_CALL Release() noexcept final
+        {
+            return this->shim().Release();
+        }
+    };
+
+    // Reads all the properties of I in a single call. Returns false for objects that don't implement the bulk
+    // properties interface, such as those from other projections, and the caller reads the properties one at a time.
+    template <typename I>
+    bool try_get_bulk_properties(void* object, bulk_properties<I>& value)
+    {
+        com_ptr<bulk_properties_abi_t<I>> bulk;
+
+        if (static_cast<unknown_abi*>(object)->QueryInterface(bulk_properties_guid<I>::value, bulk.put_void()) != error_ok)
+        {
+            return false;
+        }
+
+        check_hresult(bulk->GetBulkProperties(put_abi(value)));
+        return true;
+    }
+
 #ifdef XLANG_WINDOWS_ABI
 
     template <typename D, typename I>
@@ -594,24 +714,32 @@ namespace xlang::impl
         }
 
         int32_t XLANG_CALL Resolve(guid const& id, void** objectReference) noexcept override
+        {
+            if (!try_increment_strong())
+            {
+                *objectReference = nullptr;
+                return error_ok;
+            }
+
+            int32_t hr = m_object->QueryInterface(id, objectReference);
+            m_strong.fetch_sub(1, std::memory_order_relaxed);
+            return hr;
+        }
+
+        // Takes a strong reference unless the object has already been destroyed.
+        bool try_increment_strong() noexcept
         {
             uint32_t target = m_strong.load(std::memory_order_relaxed);
 
-            while (true)
+            while (target != 0)
             {
-                if (target == 0)
-                {
-                    *objectReference = nullptr;
-                    return error_ok;
-                }
-
                 if (m_strong.compare_exchange_weak(target, target + 1, std::memory_order_acquire, std::memory_order_relaxed))
                 {
-                    int32_t hr = m_object->QueryInterface(id, objectReference);
-                    m_strong.fetch_sub(1, std::memory_order_relaxed);
-                    return hr;
+                    return true;
                 }
             }
+
+            return false;
         }
 
         void set_strong(uint32_t const count) noexcept
@@ -952,9 +1080,25 @@ namespace xlang::impl
 
             xlang::weak_ref<T> result;
             check_hresult(source->GetWeakReference(result.put()));
+
+            // A composable object's references are counted by its outer object, so it must be resolved through
+            // IWeakReference to reach it.
+            if constexpr (!std::disjunction_v<std::is_same<composable, I>...>)
+            {
+                result.m_object = static_cast<D*>(this);
+            }
+
             return result;
         }
 
+        // Resolves a weak reference obtained from get_weak, which is known to be this object's own, to a strong
+        // reference to the object itself. Unlike IWeakReference::Resolve, this doesn't query for an interface and
+        // then drop the extra reference, so it costs a single compare exchange.
+        static bool try_resolve_weak(impl::IWeakReference* weak) noexcept
+        {
+            return static_cast<weak_ref_t*>(weak)->try_increment_strong();
+        }
+
         using is_factory = std::disjunction<std::is_same<Windows::Foundation::IActivationFactory, I>...>;
 
     private:
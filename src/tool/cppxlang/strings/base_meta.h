@@ -14,6 +14,9 @@ namespace xlang
     template <typename T>
     struct com_ptr;
 
+    template <typename I>
+    struct bulk_properties;
+
     namespace param
     {
         template <typename T>
@@ -52,6 +55,9 @@ namespace xlang::impl
     template <typename T>
     struct reference_traits;
 
+    template <typename D, typename... I>
+    struct root_implements;
+
     template <typename T>
     struct identity
     {
@@ -76,6 +82,14 @@ namespace xlang::impl
     template <typename T>
     struct consume;
 
+    template <typename I>
+    struct bulk_properties_abi
+    {
+    };
+
+    template <typename I>
+    using bulk_properties_abi_t = typename bulk_properties_abi<I>::type;
+
     template <typename D, typename I = D>
     using consume_t = typename consume<I>::template type<D>;
 
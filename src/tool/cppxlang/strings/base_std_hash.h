@@ -1,31 +1,82 @@
 
 namespace xlang::impl
 {
+    constexpr uint64_t rotate_left(uint64_t const value, int const shift) noexcept
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    constexpr uint64_t hash_finalize(uint64_t value) noexcept
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+    // Hashes eight bytes at a time with the xxHash64 round function, whatever the width of size_t.
     inline size_t hash_data(void const* ptr, size_t const bytes) noexcept
     {
-#ifdef _WIN64
-        constexpr size_t fnv_offset_basis = 14695981039346656037ULL;
-        constexpr size_t fnv_prime = 1099511628211ULL;
-#else
-        constexpr size_t fnv_offset_basis = 2166136261U;
-        constexpr size_t fnv_prime = 16777619U;
-#endif
-        size_t result = fnv_offset_basis;
-        uint8_t const* const buffer = static_cast<uint8_t const*>(ptr);
+        constexpr uint64_t prime1 = 0x9e3779b185ebca87ULL;
+        constexpr uint64_t prime2 = 0xc2b2ae3d27d4eb4fULL;
+
+        auto round = [](uint64_t const word) noexcept
+        {
+            return rotate_left(word * prime2, 31) * prime1;
+        };
+
+        uint8_t const* buffer = static_cast<uint8_t const*>(ptr);
+        size_t remaining = bytes;
+        uint64_t result = static_cast<uint64_t>(bytes) * prime1;
 
-        for (size_t next = 0; next < bytes; ++next)
+        for (; remaining >= sizeof(uint64_t); remaining -= sizeof(uint64_t), buffer += sizeof(uint64_t))
         {
-            result ^= buffer[next];
-            result *= fnv_prime;
+            uint64_t word;
+            std::memcpy(&word, buffer, sizeof(word));
+            result = rotate_left(result ^ round(word), 27) * prime1 + prime2;
         }
 
+        if (remaining)
+        {
+            uint64_t word{};
+            std::memcpy(&word, buffer, remaining);
+            result ^= round(word);
+        }
+
+        return static_cast<size_t>(hash_finalize(result));
+    }
+
+    // Pointers are aligned, so their low bits must be mixed into the rest before they can be used as a hash.
+    inline size_t hash_pointer(void const* ptr) noexcept
+    {
+        return static_cast<size_t>(hash_finalize(reinterpret_cast<uintptr_t>(ptr)));
+    }
+
+    // Returns the object's IUnknown pointer, which is the same for all of its interfaces, without keeping a
+    // reference to it. The pointer stays valid for as long as the caller holds a reference to the object.
+    inline void* get_identity(void* abi) noexcept
+    {
+        if (!abi)
+        {
+            return nullptr;
+        }
+
+        void* result{};
+
+        if (error_ok != static_cast<unknown_abi*>(abi)->QueryInterface(guid_of<Windows::Foundation::IUnknown>(), &result))
+        {
+            return abi;
+        }
+
+        static_cast<unknown_abi*>(result)->Release();
         return result;
     }
 
     inline size_t hash_unknown(Windows::Foundation::IUnknown const& value) noexcept
     {
-        void* const abi_value = get_abi(value.try_as<Windows::Foundation::IUnknown>());
-        return std::hash<void*>{}(abi_value);
+        return hash_pointer(get_identity(get_abi(value)));
     }
 
     template<typename T>
@@ -38,6 +89,51 @@ namespace xlang::impl
     };
 }
 
+namespace xlang
+{
+    // Keys a container by object identity. The identity is looked up once, when the key is created, so hashing
+    // and comparing keys doesn't call QueryInterface the way hashing and comparing the objects themselves does.
+    template <typename T>
+    struct object_key
+    {
+        object_key(T const& object) noexcept :
+            m_object(object),
+            m_identity(impl::get_identity(get_abi(m_object)))
+        {
+        }
+
+        T const& get() const noexcept
+        {
+            return m_object;
+        }
+
+        void* identity() const noexcept
+        {
+            return m_identity;
+        }
+
+        friend bool operator==(object_key const& left, object_key const& right) noexcept
+        {
+            return left.m_identity == right.m_identity;
+        }
+
+        friend bool operator!=(object_key const& left, object_key const& right) noexcept
+        {
+            return left.m_identity != right.m_identity;
+        }
+
+        friend bool operator<(object_key const& left, object_key const& right) noexcept
+        {
+            return std::less<void*>{}(left.m_identity, right.m_identity);
+        }
+
+    private:
+
+        T m_object;
+        void* m_identity;
+    };
+}
+
 namespace std
 {
     template<> struct hash<xlang::hstring>
@@ -49,6 +145,14 @@ namespace std
         }
     };
 
+    template <typename T> struct hash<xlang::object_key<T>>
+    {
+        size_t operator()(xlang::object_key<T> const& value) const noexcept
+        {
+            return xlang::impl::hash_pointer(value.identity());
+        }
+    };
+
     template<> struct hash<xlang::Windows::Foundation::IUnknown> : xlang::impl::hash_base<xlang::Windows::Foundation::IUnknown> {};
     template<> struct hash<xlang::Windows::Foundation::IXlangObject> : xlang::impl::hash_base<xlang::Windows::Foundation::IXlangObject> {};
     template<> struct hash<xlang::Windows::Foundation::IActivationFactory> : xlang::impl::hash_base<xlang::Windows::Foundation::IActivationFactory> {};
@@ -374,6 +374,137 @@ namespace xlang
 #endif
 }
 
+namespace xlang::impl
+{
+    // Converts UTF-8 to UTF-16 during constant evaluation, returning the number of code units written. Malformed
+    // input throws, which fails the evaluation and so the build.
+    constexpr uint32_t static_utf8_to_utf16(xlang_char8 const* source, uint32_t const length, char16_t* destination)
+    {
+        uint32_t written{};
+
+        for (uint32_t index{}; index < length;)
+        {
+            uint32_t const lead = static_cast<uint8_t>(source[index++]);
+            uint32_t trailing{};
+            uint32_t code_point{};
+
+            if (lead < 0x80)
+            {
+                code_point = lead;
+            }
+            else if ((lead & 0xe0) == 0xc0)
+            {
+                code_point = lead & 0x1f;
+                trailing = 1;
+            }
+            else if ((lead & 0xf0) == 0xe0)
+            {
+                code_point = lead & 0x0f;
+                trailing = 2;
+            }
+            else if ((lead & 0xf8) == 0xf0)
+            {
+                code_point = lead & 0x07;
+                trailing = 3;
+            }
+            else
+            {
+                throw std::invalid_argument("Invalid UTF-8");
+            }
+
+            for (; trailing; --trailing)
+            {
+                uint32_t const next = index < length ? static_cast<uint8_t>(source[index++]) : 0;
+
+                if ((next & 0xc0) != 0x80)
+                {
+                    throw std::invalid_argument("Invalid UTF-8");
+                }
+
+                code_point = (code_point << 6) | (next & 0x3f);
+            }
+
+            if (code_point > 0x10ffff || (code_point >= 0xd800 && code_point <= 0xdfff))
+            {
+                throw std::invalid_argument("Invalid UTF-8");
+            }
+
+            if (code_point < 0x10000)
+            {
+                destination[written++] = static_cast<char16_t>(code_point);
+            }
+            else
+            {
+                code_point -= 0x10000;
+                destination[written++] = static_cast<char16_t>(0xd800 + (code_point >> 10));
+                destination[written++] = static_cast<char16_t>(0xdc00 + (code_point & 0x3ff));
+            }
+        }
+
+        return written;
+    }
+}
+
+namespace xlang
+{
+    // A string built at compile time, in both encodings, that is never freed. Copying it into an hstring, or
+    // passing it as one, duplicates the handle without allocating or reference counting. Declare it static
+    // constexpr, since the handle points into the object itself:
+    //
+    //     static constexpr static_hstring name{ u8"Widget" };
+    //
+    // A literal operator would need a string literal as a template argument, which C++17 doesn't allow.
+    template <size_t N>
+    struct static_hstring
+    {
+        static_assert(N > 0, "Must be constructed from a string literal.");
+
+        constexpr static_hstring(xlang_char8 const(&value)[N]) :
+            m_handle(N > 1 ? &m_header : nullptr),
+            m_header{ xlang_static_string_flags, N - 1, { &m_utf16 }, m_utf8 }
+        {
+            for (size_t index{}; index < N; ++index)
+            {
+                m_utf8[index] = value[index];
+            }
+
+            m_utf16.header.length = impl::static_utf8_to_utf16(value, N - 1, m_utf16.buffer);
+        }
+
+        static_hstring(static_hstring const&) = delete;
+        static_hstring& operator=(static_hstring const&) = delete;
+
+        operator hstring const&() const noexcept
+        {
+            return *reinterpret_cast<hstring const*>(this);
+        }
+
+        constexpr std::basic_string_view<xlang_char8> view() const noexcept
+        {
+            return { m_utf8, N - 1 };
+        }
+
+    private:
+
+        struct utf16_type
+        {
+            xlang_static_string_utf16 header;
+            char16_t buffer[N];
+        };
+
+        void const* m_handle;
+        xlang_static_string_header m_header;
+        utf16_type m_utf16{};
+        xlang_char8 m_utf8[N]{};
+    };
+
+    template <size_t N>
+    inline xlang_string get_abi(static_hstring<N> const& object) noexcept
+    {
+        return get_abi(static_cast<hstring const&>(object));
+    }
+}
+
 namespace xlang::impl
 {
     template <> struct abi<hstring>
@@ -10,10 +10,19 @@ namespace xlang::param
 
         ~hstring() noexcept
         {
-            xlang_delete_string(m_handle);
+            if (!m_borrowed)
+            {
+                xlang_delete_string(m_handle);
+            }
+        }
+
+        // Borrows the handle, which remains owned by the caller's hstring.
+        hstring(xlang::hstring const& value) noexcept : m_handle(get_abi(value)), m_borrowed(true)
+        {
         }
 
-        hstring(xlang::hstring const& value) noexcept : m_handle(get_abi(value))
+        template <size_t N>
+        hstring(static_hstring<N> const& value) noexcept : hstring(static_cast<xlang::hstring const&>(value))
         {
         }
 
@@ -110,6 +119,7 @@ namespace xlang::param
 
         xlang_string m_handle;
         xlang_string_header m_header;
+        bool m_borrowed{};
     };
 
     inline xlang_string get_abi(hstring const& object) noexcept
@@ -12,7 +12,7 @@ namespace xlang
             {
                 if constexpr(impl::is_implements_v<T>)
                 {
-                    m_ref = std::move(object->get_weak().m_ref);
+                    *this = object->get_weak();
                 }
                 else
                 {
@@ -30,8 +30,24 @@ namespace xlang
 
             if constexpr(impl::is_implements_v<T>)
             {
+                if (m_object)
+                {
+                    if (!T::try_resolve_weak(m_ref.get()))
+                    {
+                        return nullptr;
+                    }
+
+                    return { m_object, take_ownership_from_abi };
+                }
+
                 impl::com_ref<default_interface<T>> temp;
                 m_ref->Resolve(guid_of<T>(), put_abi(temp));
+
+                if (!temp)
+                {
+                    return nullptr;
+                }
+
                 void* result = get_self<T>(temp);
                 detach_abi(temp);
                 return { result, take_ownership_from_abi };
@@ -46,6 +62,7 @@ namespace xlang
 
         auto put() noexcept
         {
+            m_object = nullptr;
             return m_ref.put();
         }
 
@@ -56,7 +73,13 @@ namespace xlang
 
     private:
 
+        template <typename D, typename... I>
+        friend struct impl::root_implements;
+
         com_ptr<impl::IWeakReference> m_ref;
+
+        // The implementation, when the weak reference came from its own get_weak and can be resolved directly.
+        void* m_object{};
     };
 
     template <typename T>